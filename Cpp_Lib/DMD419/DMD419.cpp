@@ -25,6 +25,34 @@
 --------------------------------------------------------------------------------------*/
 #include "DMD419.h"
 
+//Link time check that the sketch was built with the same DMD419_NATIVE_POLARITY (see DMD419.h)
+const byte DMD419_POLARITY_CHECK = DMD419_NATIVE_POLARITY;
+
+volatile byte DMD419::spiLockDepth = 0;
+void * volatile DMD419::pendingScan = 0;
+void (* volatile DMD419::pendingScanPhase)(void *) = 0;
+byte DMD419::savedSPCR;
+byte DMD419::savedSPSR;
+
+//Glyph offset index for variable width fonts: the sum of the widths before every
+//GLYPH_INDEX_STRIDE'th glyph, so finding a glyph reads at most 7 widths instead of the whole
+//table up to that character. One 64 byte index serves every display and is rebuilt when a
+//display with another font draws.
+#define GLYPH_INDEX_STRIDE  8
+static const uint8_t* glyphIndexFont = 0;
+static uint16_t glyphIndex[256 / GLYPH_INDEX_STRIDE];
+
+static void buildGlyphIndex(const uint8_t* font)
+{
+    uint8_t charCount = pgm_read_byte(font + FONT_CHAR_COUNT);
+    uint16_t sum = 0;
+    for (uint8_t i = 0; i < charCount; i++) {
+	    if ((i & (GLYPH_INDEX_STRIDE - 1)) == 0) glyphIndex[i / GLYPH_INDEX_STRIDE] = sum;
+	    sum += pgm_read_byte(font + FONT_WIDTH_TABLE + i);
+    }
+    glyphIndexFont = font;
+}
+
 /*--------------------------------------------------------------------------------------
  Setup and instantiation of DMD419 library
  Note this currently uses the SPI port for the fastest performance to the DMD419, be
@@ -65,6 +93,8 @@ DMD419::DMD419(byte panelsWide, byte panelsHigh)
 
     // init the scan line/ram pointer to the required start point
     bDMD419Byte = 0;
+    deferredScans = 0;
+    skippedScans = 0;
 }
 
 //DMD419::~DMD419()
@@ -94,34 +124,30 @@ void
     switch (bGraphicsMode) {
     case GRAPHICS_NORMAL:
 	    if (bPixel == true)
-		bDMD419ScreenRAM[uiDMD419RAMPointer] &= ~lookup;	// zero bit is pixel on
+		DMD419_RAM_PIXEL_ON(bDMD419ScreenRAM[uiDMD419RAMPointer], lookup);
 	    else
-		bDMD419ScreenRAM[uiDMD419RAMPointer] |= lookup;	// one bit is pixel off
+		DMD419_RAM_PIXEL_OFF(bDMD419ScreenRAM[uiDMD419RAMPointer], lookup);
 	    break;
     case GRAPHICS_INVERSE:
 	    if (bPixel == false)
-		    bDMD419ScreenRAM[uiDMD419RAMPointer] &= ~lookup;	// zero bit is pixel on
+		    DMD419_RAM_PIXEL_ON(bDMD419ScreenRAM[uiDMD419RAMPointer], lookup);
 	    else
-		    bDMD419ScreenRAM[uiDMD419RAMPointer] |= lookup;	// one bit is pixel off
+		    DMD419_RAM_PIXEL_OFF(bDMD419ScreenRAM[uiDMD419RAMPointer], lookup);
 	    break;
     case GRAPHICS_TOGGLE:
-	    if (bPixel == true) {
-		if ((bDMD419ScreenRAM[uiDMD419RAMPointer] & lookup) == 0)
-		    bDMD419ScreenRAM[uiDMD419RAMPointer] |= lookup;	// one bit is pixel off
-		else
-		    bDMD419ScreenRAM[uiDMD419RAMPointer] &= ~lookup;	// one bit is pixel off
-	    }
+	    if (bPixel == true)
+		bDMD419ScreenRAM[uiDMD419RAMPointer] ^= lookup;	// same for both polarities
 	    break;
     case GRAPHICS_OR:
+    case GRAPHICS_TRANSPARENT:
 	    //only set pixels on
 	    if (bPixel == true)
-		    bDMD419ScreenRAM[uiDMD419RAMPointer] &= ~lookup;	// zero bit is pixel on
+		    DMD419_RAM_PIXEL_ON(bDMD419ScreenRAM[uiDMD419RAMPointer], lookup);
 	    break;
     case GRAPHICS_NOR:
 	    //only clear on pixels
-	    if ((bPixel == true) &&
-		    ((bDMD419ScreenRAM[uiDMD419RAMPointer] & lookup) == 0))
-		    bDMD419ScreenRAM[uiDMD419RAMPointer] |= lookup;	// one bit is pixel off
+	    if (bPixel == true)
+		    DMD419_RAM_PIXEL_OFF(bDMD419ScreenRAM[uiDMD419RAMPointer], lookup);
 	    break;
     }
 
@@ -130,25 +156,59 @@ void
 void DMD419::drawString(int bX, int bY, const char *bChars, byte length,
 		     byte bGraphicsMode)
 {
-    if (bX >= (DMD419_PIXELS_ACROSS*DisplaysWide) || bY >= DMD419_PIXELS_DOWN * DisplaysHigh)
+    drawText(canvas(), this->Font, bX, bY, bChars, length, bGraphicsMode);
+}
+
+/*--------------------------------------------------------------------------------------
+ Draw a string with a blank column before and after every character (drawString(),
+ DMD419T::drawString())
+--------------------------------------------------------------------------------------*/
+void DMD419::drawText(const DMD419Canvas &c, const uint8_t *font, int bX, int bY,
+		   const char *bChars, byte length, byte bGraphicsMode)
+{
+    int pixelsWide = DMD419_PIXELS_ACROSS * c.displaysWide;
+    int pixelsHigh = DMD419_PIXELS_DOWN * c.displaysHigh;
+    if (bX >= pixelsWide || bY >= pixelsHigh)
 	return;
-    uint8_t height = pgm_read_byte(this->Font + FONT_HEIGHT);
+    uint8_t height = pgm_read_byte(font + FONT_HEIGHT);
     if (bY+height<0) return;
 
+    // transparent text leaves the blank columns between characters alone
+    boolean opaque = (bGraphicsMode != GRAPHICS_TRANSPARENT);
     int strWidth = 0;
-	this->drawLine(bX -1 , bY, bX -1 , bY + height, GRAPHICS_INVERSE);
+    if (opaque) fillBox(c, bX -1 , bY, bX -1 , bY + height, GRAPHICS_INVERSE);
 
     for (int i = 0; i < length; i++) {
-        int charWide = this->drawChar(bX+strWidth, bY, bChars[i], bGraphicsMode);
+        int charWide = drawGlyph(c, font, bX+strWidth, bY, bChars[i], bGraphicsMode);
 	    if (charWide > 0) {
 	        strWidth += charWide ;
-	        this->drawLine(bX + strWidth , bY, bX + strWidth , bY + height, GRAPHICS_INVERSE);
+	        if (opaque) fillBox(c, bX + strWidth , bY, bX + strWidth , bY + height, GRAPHICS_INVERSE);
             strWidth++;
         } else if (charWide < 0) {
             return;
         }
-        if ((bX + strWidth) >= DMD419_PIXELS_ACROSS * DisplaysWide || bY >= DMD419_PIXELS_DOWN * DisplaysHigh) return;
+        if ((bX + strWidth) >= pixelsWide) return;
+    }
+}
+
+int DMD419::stringWidth(const char *bChars, byte length)
+{
+    int strWidth = 0;
+    for (int i = 0; i < length; i++) {
+        int charWide = charWidth(bChars[i]);
+        if (charWide > 0) strWidth += charWide + 1;
     }
+    return strWidth;
+}
+
+void DMD419::clearStringBand(int bX, int bY, const char *bChars, byte length)
+{
+    if (bX >= (DMD419_PIXELS_ACROSS*DisplaysWide) || bY >= DMD419_PIXELS_DOWN * DisplaysHigh)
+	return;
+    // the leading blank column, every character and the blank column after it, as tall as
+    // the separator lines of an opaque drawString()
+    uint8_t height = pgm_read_byte(this->Font + FONT_HEIGHT);
+    drawFilledBox(bX - 1, bY, bX + stringWidth(bChars, length) - 1, bY + height, GRAPHICS_INVERSE);
 }
 
 void DMD419::drawMarquee(const char *bChars, byte length, int left, int top)
@@ -194,53 +254,135 @@ boolean DMD419::stepMarquee(int amountX, int amountY)
         ret=true;
     }
 
-    // Special case horizontal scrolling to improve speed
-    if (amountY==0 && amountX==-1) {
-        // Shift entire screen one bit
-        for (int i=0; i<DMD419_RAM_SIZE_BYTES*DisplaysTotal;i++) {
-            if ((i%(DisplaysWide*4)) == (DisplaysWide*4) -1) {
-                bDMD419ScreenRAM[i]=(bDMD419ScreenRAM[i]<<1)+1;
-            } else {
-                bDMD419ScreenRAM[i]=(bDMD419ScreenRAM[i]<<1) + ((bDMD419ScreenRAM[i+1] & 0x80) >>7);
-            }
+    int pixelsWide = DMD419_PIXELS_ACROSS * DisplaysWide;
+    int pixelsHigh = DMD419_PIXELS_DOWN * DisplaysHigh;
+    int stepX = amountX < 0 ? -amountX : amountX;
+    int stepY = amountY < 0 ? -amountY : amountY;
+
+    // Wrapped around (screen was cleared) or a jump larger than the screen: redraw everything
+    if (ret || stepX >= pixelsWide || stepY >= pixelsHigh) {
+        drawString(marqueeOffsetX, marqueeOffsetY, marqueeText, marqueeLength,
+	       GRAPHICS_NORMAL);
+        return ret;
+    }
+
+    // Move what is already on screen, then only draw what scrolled in from outside
+    if (amountY != 0) {
+        shiftRows(amountY);
+    }
+    if (amountX != 0) {
+        shiftColumns(amountX);
+    }
+
+    // Rows uncovered at the top or bottom: redraw if the text band reaches into them
+    if ((amountY < 0 && marqueeOffsetY + marqueeHeight >= pixelsHigh - stepY) ||
+        (amountY > 0 && marqueeOffsetY < stepY)) {
+        drawString(marqueeOffsetX, marqueeOffsetY, marqueeText, marqueeLength,
+	       GRAPHICS_NORMAL);
+        return ret;
+    }
+    if (amountX == 0) {
+        return ret;
+    }
+
+    // Redraw the characters that overlap the columns uncovered by the shift
+    int edgeFrom = (amountX < 0) ? pixelsWide - stepX : 0;
+    int edgeTo = (amountX < 0) ? pixelsWide - 1 : stepX - 1;
+    int strWidth = marqueeOffsetX;
+    for (byte i = 0; i < marqueeLength && strWidth <= edgeTo; i++) {
+        int wide = charWidth(marqueeText[i]);
+        if (strWidth + wide >= edgeFrom) {
+            drawChar(strWidth, marqueeOffsetY, marqueeText[i], GRAPHICS_NORMAL);
         }
+        strWidth += wide + 1;
+    }
+
+    return ret;
+}
 
-        // Redraw last char on screen
-        int strWidth=marqueeOffsetX;
-        for (byte i=0; i < marqueeLength; i++) {
-            int wide = charWidth(marqueeText[i]);
-            if (strWidth+wide >= DisplaysWide*DMD419_PIXELS_ACROSS) {
-                drawChar(strWidth, marqueeOffsetY,marqueeText[i],GRAPHICS_NORMAL);
-                return ret;
+/*--------------------------------------------------------------------------------------
+ Shift every pixel row amountX pixels right (positive) or left (negative), 0 < |amountX| < width.
+ Each pixel row is a run of DisplaysWide*4 bytes and the runs are back to back in RAM, so the
+ loop just walks the runs; uncovered pixels are switched off.
+--------------------------------------------------------------------------------------*/
+void DMD419::shiftColumns(int amountX)
+{
+    int runBytes = DisplaysWide << 2;
+    byte *end = bDMD419ScreenRAM + DMD419_RAM_SIZE_BYTES * DisplaysTotal;
+    int step = amountX < 0 ? -amountX : amountX;
+    int q = step >> 3;          // whole bytes
+    byte r = step & 0x07;       // remaining bits
+
+    for (byte *run = bDMD419ScreenRAM; run < end; run += runBytes) {
+        if (amountX < 0) {
+            // pixels move left: byte i takes bits from bytes i+q and i+q+1
+            for (int i = 0; i < runBytes; i++) {
+                byte hi = (i + q < runBytes) ? run[i + q] : DMD419_RAM_ALL_OFF;
+                byte lo = (i + q + 1 < runBytes) ? run[i + q + 1] : DMD419_RAM_ALL_OFF;
+                run[i] = r ? (byte)((hi << r) | (lo >> (8 - r))) : hi;
             }
-            strWidth += wide+1;
-        }
-    } else if (amountY==0 && amountX==1) {
-        // Shift entire screen one bit
-        for (int i=(DMD419_RAM_SIZE_BYTES*DisplaysTotal)-1; i>=0;i--) {
-            if ((i%(DisplaysWide*4)) == 0) {
-                bDMD419ScreenRAM[i]=(bDMD419ScreenRAM[i]>>1)+128;
-            } else {
-                bDMD419ScreenRAM[i]=(bDMD419ScreenRAM[i]>>1) + ((bDMD419ScreenRAM[i-1] & 1) <<7);
+        } else {
+            // pixels move right: byte i takes bits from bytes i-q and i-q-1
+            for (int i = runBytes - 1; i >= 0; i--) {
+                byte lo = (i - q >= 0) ? run[i - q] : DMD419_RAM_ALL_OFF;
+                byte hi = (i - q - 1 >= 0) ? run[i - q - 1] : DMD419_RAM_ALL_OFF;
+                run[i] = r ? (byte)((lo >> r) | (hi << (8 - r))) : lo;
             }
         }
+    }
+}
 
-        // Redraw last char on screen
-        int strWidth=marqueeOffsetX;
-        for (byte i=0; i < marqueeLength; i++) {
-            int wide = charWidth(marqueeText[i]);
-            if (strWidth+wide >= 0) {
-                drawChar(strWidth, marqueeOffsetY,marqueeText[i],GRAPHICS_NORMAL);
-                return ret;
-            }
-            strWidth += wide+1;
+/*--------------------------------------------------------------------------------------
+ Move every pixel row amountY rows down (positive) or up (negative), 0 < |amountY| < height.
+ Pixel row y lives at (y%16)*DisplaysTotal*4 + (y/16)*DisplaysWide*4; the row cursors step
+ through that layout incrementally, so there is no division per row.
+--------------------------------------------------------------------------------------*/
+void DMD419::shiftRows(int amountY)
+{
+    int runBytes = DisplaysWide << 2;
+    int rowsize = DisplaysTotal << 2;
+    int pixelsHigh = DMD419_PIXELS_DOWN * DisplaysHigh;
+    int step = amountY < 0 ? -amountY : amountY;
+    int lastPanelRow = (DisplaysHigh - 1) * runBytes;
+
+    // cursors start at the top row (moving up) or the bottom row (moving down)
+    byte dstY = (amountY < 0) ? 0 : DMD419_PIXELS_DOWN - 1;
+    byte *dst = bDMD419ScreenRAM + ((amountY < 0) ? 0 : dstY * rowsize + lastPanelRow);
+    byte srcY = dstY;
+    byte *src = dst;
+    for (int k = 0; k < step; k++) {
+        nextRow(src, srcY, amountY < 0, rowsize, runBytes);
+    }
+
+    for (int k = 0; k < pixelsHigh; k++) {
+        if (k < pixelsHigh - step) {
+            memcpy(dst, src, runBytes);
+            nextRow(src, srcY, amountY < 0, rowsize, runBytes);
+        } else {
+            memset(dst, DMD419_RAM_ALL_OFF, runBytes);
         }
-    } else {
-        drawString(marqueeOffsetX, marqueeOffsetY, marqueeText, marqueeLength,
-	       GRAPHICS_NORMAL);
+        nextRow(dst, dstY, amountY < 0, rowsize, runBytes);
     }
+}
 
-    return ret;
+// Step a row cursor one pixel row down (forward) or up, crossing panel rows every 16 rows
+inline void DMD419::nextRow(byte *&row, byte &bY, boolean forward, int rowsize, int runBytes)
+{
+    if (forward) {
+        if (++bY == DMD419_PIXELS_DOWN) {
+            bY = 0;
+            row += runBytes - (DMD419_PIXELS_DOWN - 1) * rowsize;
+        } else {
+            row += rowsize;
+        }
+    } else {
+        if (bY-- == 0) {
+            bY = DMD419_PIXELS_DOWN - 1;
+            row += (DMD419_PIXELS_DOWN - 1) * rowsize - runBytes;
+        } else {
+            row -= rowsize;
+        }
+    }
 }
 
 
@@ -250,9 +392,9 @@ boolean DMD419::stepMarquee(int amountX, int amountY)
 void DMD419::clearScreen(byte bNormal)
 {
     if (bNormal) // clear all pixels
-        memset(bDMD419ScreenRAM,0xFF,DMD419_RAM_SIZE_BYTES*DisplaysTotal);
+        memset(bDMD419ScreenRAM,DMD419_RAM_ALL_OFF,DMD419_RAM_SIZE_BYTES*DisplaysTotal);
     else // set all pixels
-        memset(bDMD419ScreenRAM,0x00,DMD419_RAM_SIZE_BYTES*DisplaysTotal);
+        memset(bDMD419ScreenRAM,(byte)~DMD419_RAM_ALL_OFF,DMD419_RAM_SIZE_BYTES*DisplaysTotal);
 }
 
 /*--------------------------------------------------------------------------------------
@@ -260,49 +402,7 @@ void DMD419::clearScreen(byte bNormal)
 --------------------------------------------------------------------------------------*/
 void DMD419::drawLine(int x1, int y1, int x2, int y2, byte bGraphicsMode)
 {
-    int dy = y2 - y1;
-    int dx = x2 - x1;
-    int stepx, stepy;
-
-    if (dy < 0) {
-	    dy = -dy;
-	    stepy = -1;
-    } else {
-	    stepy = 1;
-    }
-    if (dx < 0) {
-	    dx = -dx;
-	    stepx = -1;
-    } else {
-	    stepx = 1;
-    }
-    dy <<= 1;			// dy is now 2*dy
-    dx <<= 1;			// dx is now 2*dx
-
-    writePixel(x1, y1, bGraphicsMode, true);
-    if (dx > dy) {
-	    int fraction = dy - (dx >> 1);	// same as 2*dy - dx
-	    while (x1 != x2) {
-	        if (fraction >= 0) {
-		        y1 += stepy;
-		        fraction -= dx;	// same as fraction -= 2*dx
-	        }
-	        x1 += stepx;
-	        fraction += dy;	// same as fraction -= 2*dy
-	        writePixel(x1, y1, bGraphicsMode, true);
-	    }
-    } else {
-	    int fraction = dx - (dy >> 1);
-	    while (y1 != y2) {
-	        if (fraction >= 0) {
-		        x1 += stepx;
-		        fraction -= dy;
-	        }
-	        y1 += stepy;
-	        fraction += dx;
-	        writePixel(x1, y1, bGraphicsMode, true);
-	    }
-    }
+    drawLineOn(*this, x1, y1, x2, y2, bGraphicsMode);
 }
 
 /*--------------------------------------------------------------------------------------
@@ -370,45 +470,108 @@ void DMD419::drawBox(int x1, int y1, int x2, int y2, byte bGraphicsMode)
 void DMD419::drawFilledBox(int x1, int y1, int x2, int y2,
 			byte bGraphicsMode)
 {
-    for (int b = x1; b <= x2; b++) {
-	    drawLine(b, y1, b, y2, bGraphicsMode);
+    fillBox(canvas(), x1, y1, x2, y2, bGraphicsMode);
+}
+
+void DMD419::fillBox(const DMD419Canvas &c, int x1, int y1, int x2, int y2,
+		  byte bGraphicsMode)
+{
+    int pixelsWide = DMD419_PIXELS_ACROSS * c.displaysWide;
+    int pixelsHigh = DMD419_PIXELS_DOWN * c.displaysHigh;
+
+    // same area as one vertical drawLine() per column: x1..x2 left to right, y1..y2 either way
+    if (y1 > y2) {
+        int t = y1; y1 = y2; y2 = t;
+    }
+    if (x1 < 0) x1 = 0;
+    if (y1 < 0) y1 = 0;
+    if (x2 >= pixelsWide) x2 = pixelsWide - 1;
+    if (y2 >= pixelsHigh) y2 = pixelsHigh - 1;
+    if (x1 > x2 || y1 > y2) return;
+
+    for (int y = y1; y <= y2; y++) {
+        fillRowSpan(c, y, x1, x2, bGraphicsMode);
+    }
+}
+
+/*--------------------------------------------------------------------------------------
+ Apply bGraphicsMode (with pixel value true) to pixels x1..x2 of row y, a byte at a time.
+ A row is contiguous in RAM across the whole chain: byte x/8 of the row starts at
+ bY*(DisplaysTotal*4) + panelRow*DisplaysWide*4. Coordinates must already be clipped.
+--------------------------------------------------------------------------------------*/
+void DMD419::fillRowSpan(const DMD419Canvas &c, int y, int x1, int x2, byte bGraphicsMode)
+{
+    byte *row = c.ram
+              + (y % DMD419_PIXELS_DOWN) * ((c.displaysWide * c.displaysHigh) << 2)
+              + (y / DMD419_PIXELS_DOWN) * (c.displaysWide << 2);
+    byte *p = row + (x1 >> 3);
+    byte *last = row + (x2 >> 3);
+    byte firstMask = 0xFF >> (x1 & 0x07);
+    byte lastMask = 0xFF << (7 - (x2 & 0x07));
+
+    if (p == last) {
+        firstMask &= lastMask;
+    }
+    applySpanMask(p, firstMask, bGraphicsMode);
+    if (p == last) return;
+
+    // whole bytes in the middle of the span
+    for (p++; p < last; p++) {
+        applySpanMask(p, 0xFF, bGraphicsMode);
+    }
+    applySpanMask(last, lastMask, bGraphicsMode);
+}
+
+// One RAM byte of a span: the pixels in mask get the same change writePixel(.., true) makes
+inline void DMD419::applySpanMask(byte *b, byte mask, byte bGraphicsMode)
+{
+    switch (bGraphicsMode) {
+    case GRAPHICS_NORMAL:
+    case GRAPHICS_OR:
+    case GRAPHICS_TRANSPARENT:
+        DMD419_RAM_PIXEL_ON(*b, mask);
+        break;
+    case GRAPHICS_INVERSE:
+    case GRAPHICS_NOR:
+        DMD419_RAM_PIXEL_OFF(*b, mask);
+        break;
+    case GRAPHICS_TOGGLE:
+        *b ^= mask;
+        break;
     }
 }
 
 /*--------------------------------------------------------------------------------------
  Draw the selected test pattern
+ Every pattern repeats per pixel row, and all rows with the same bY share one contiguous
+ run of DisplaysTotal*4 bytes in RAM (and the same row parity), so each run is one memset.
 --------------------------------------------------------------------------------------*/
 void DMD419::drawTestPattern(byte bPattern)
 {
-    unsigned int ui;
-
-    int numPixels=DisplaysTotal * DMD419_PIXELS_ACROSS * DMD419_PIXELS_DOWN;
-    int pixelsWide=DMD419_PIXELS_ACROSS*DisplaysWide;
-    for (ui = 0; ui < numPixels; ui++) {
-	    switch (bPattern) {
-	    case PATTERN_ALT_0:	// every alternate pixel, first pixel on
-		    if ((ui & pixelsWide) == 0)
-		        //even row
-		        writePixel((ui & (pixelsWide-1)), ((ui & ~(pixelsWide-1)) / pixelsWide), GRAPHICS_NORMAL, ui & 1);
-		    else
-		        //odd row
-		        writePixel((ui & (pixelsWide-1)), ((ui & ~(pixelsWide-1)) / pixelsWide), GRAPHICS_NORMAL, !(ui & 1));
-		    break;
-	    case PATTERN_ALT_1:	// every alternate pixel, first pixel off
-		    if ((ui & pixelsWide) == 0)
-		        //even row
-		        writePixel((ui & (pixelsWide-1)), ((ui & ~(pixelsWide-1)) / pixelsWide), GRAPHICS_NORMAL, !(ui & 1));
-		    else
-		        //odd row
-		        writePixel((ui & (pixelsWide-1)), ((ui & ~(pixelsWide-1)) / pixelsWide), GRAPHICS_NORMAL, ui & 1);
-		    break;
-	    case PATTERN_STRIPE_0:	// vertical stripes, first stripe on
-		    writePixel((ui & (pixelsWide-1)), ((ui & ~(pixelsWide-1)) / pixelsWide), GRAPHICS_NORMAL, ui & 1);
-		    break;
-	    case PATTERN_STRIPE_1:	// vertical stripes, first stripe off
-		    writePixel((ui & (pixelsWide-1)), ((ui & ~(pixelsWide-1)) / pixelsWide), GRAPHICS_NORMAL, !(ui & 1));
-		    break;
-        }
+    // lit pixels per byte for even and odd rows, leftmost pixel in bit 7
+    byte evenRow, oddRow;
+
+    switch (bPattern) {
+    case PATTERN_ALT_0:	// every alternate pixel, odd columns lit on even rows
+        evenRow = 0x55; oddRow = 0xAA;
+        break;
+    case PATTERN_ALT_1:	// every alternate pixel, even columns lit on even rows
+        evenRow = 0xAA; oddRow = 0x55;
+        break;
+    case PATTERN_STRIPE_0:	// vertical stripes, odd columns lit
+        evenRow = 0x55; oddRow = 0x55;
+        break;
+    case PATTERN_STRIPE_1:	// vertical stripes, even columns lit
+        evenRow = 0xAA; oddRow = 0xAA;
+        break;
+    default:
+        return;
+    }
+
+    int rowsize = DisplaysTotal << 2;
+    for (byte bY = 0; bY < DMD419_PIXELS_DOWN; bY++) {
+        byte lit = (bY & 1) ? oddRow : evenRow;
+        memset(bDMD419ScreenRAM + bY * rowsize, DMD419_RAM_TO_WIRE(lit), rowsize);
     }
 }
 
@@ -419,113 +582,251 @@ void DMD419::drawTestPattern(byte bPattern)
 --------------------------------------------------------------------------------------*/
 void DMD419::scanDisplayBySPI()
 {
-    //if PIN_OTHER_SPI_nCS is in use during a DMD419 scan request then scanDisplayBySPI() will exit without conflict! (and skip that scan)
-    if( digitalRead( PIN_OTHER_SPI_nCS ) == HIGH )
-    {
-        //SPI transfer pixels to the display hardware shift registers
-        int rowsize=DisplaysTotal<<2;
-        int offset=rowsize * bDMD419Byte;
-        for (int i=0;i<DisplaysTotal;i++) {
-            SPI.transfer(~bDMD419ScreenRAM[offset+0+row3]);    
-            SPI.transfer(~bDMD419ScreenRAM[offset+0+row2]);
-            SPI.transfer(~bDMD419ScreenRAM[offset+1+row3]);
-            SPI.transfer(~bDMD419ScreenRAM[offset+1+row2]);
-            SPI.transfer(~bDMD419ScreenRAM[offset+0+row1]);
-            SPI.transfer(~bDMD419ScreenRAM[offset+0]);
-            SPI.transfer(~bDMD419ScreenRAM[offset+1+row1]);
-            SPI.transfer(~bDMD419ScreenRAM[offset+1]);
-            SPI.transfer(~bDMD419ScreenRAM[offset+2+row3]);    
-            SPI.transfer(~bDMD419ScreenRAM[offset+2+row2]);
-            SPI.transfer(~bDMD419ScreenRAM[offset+3+row3]);
-            SPI.transfer(~bDMD419ScreenRAM[offset+3+row2]);
-            SPI.transfer(~bDMD419ScreenRAM[offset+2+row1]);
-            SPI.transfer(~bDMD419ScreenRAM[offset+2]);
-            SPI.transfer(~bDMD419ScreenRAM[offset+3+row1]);
-            SPI.transfer(~bDMD419ScreenRAM[offset+3]);
+    if (spiLockDepth != 0) {
+        //another SPI user holds the bus: run this scan as soon as it calls unlockSPI()
+        if (deferScan(this, scanPending)) {
+            deferredScans++;
+        } else {
+            skippedScans++;
         }
+        return;
+    }
+    //if PIN_OTHER_SPI_nCS is in use during a DMD419 scan request then scanDisplayBySPI() will exit without conflict! (and skip that scan)
+    if( digitalRead( PIN_OTHER_SPI_nCS ) == LOW ) {
+        skippedScans++;
+        return;
+    }
+    scanPhase();
+}
 
-        OE_DMD419_ROWS_OFF();
-        LATCH_DMD419_SHIFT_REG_TO_OUTPUT();
-        switch (bDMD419Byte) {
-        case 0:			// row 1, 5, 9, 13 were clocked out
-            LIGHT_DMD419_ROW_01_05_09_13();
-            bDMD419Byte=1;
-            break;
-        case 1:			// row 2, 6, 10, 14 were clocked out
-            LIGHT_DMD419_ROW_02_06_10_14();
-            bDMD419Byte=2;
-            break;
-        case 2:			// row 3, 7, 11, 15 were clocked out
-            LIGHT_DMD419_ROW_03_07_11_15();
-            bDMD419Byte=3;
-            break;
-        case 3:			// row 4, 8, 12, 16 were clocked out
-            LIGHT_DMD419_ROW_04_08_12_16();
-            bDMD419Byte=0;
-            break;
-        }
-        OE_DMD419_ROWS_ON();
+/*--------------------------------------------------------------------------------------
+ Clock one phase (4 interleaved rows) out of the RAM mirror and light it
+--------------------------------------------------------------------------------------*/
+void DMD419::scanPhase()
+{
+    //SPI transfer pixels to the display hardware shift registers
+    int rowsize=DisplaysTotal<<2;
+    int offset=rowsize * bDMD419Byte;
+    for (int i=0;i<DisplaysTotal;i++) {
+        SPI.transfer(DMD419_RAM_TO_WIRE(bDMD419ScreenRAM[offset+0+row3]));    
+        SPI.transfer(DMD419_RAM_TO_WIRE(bDMD419ScreenRAM[offset+0+row2]));
+        SPI.transfer(DMD419_RAM_TO_WIRE(bDMD419ScreenRAM[offset+1+row3]));
+        SPI.transfer(DMD419_RAM_TO_WIRE(bDMD419ScreenRAM[offset+1+row2]));
+        SPI.transfer(DMD419_RAM_TO_WIRE(bDMD419ScreenRAM[offset+0+row1]));
+        SPI.transfer(DMD419_RAM_TO_WIRE(bDMD419ScreenRAM[offset+0]));
+        SPI.transfer(DMD419_RAM_TO_WIRE(bDMD419ScreenRAM[offset+1+row1]));
+        SPI.transfer(DMD419_RAM_TO_WIRE(bDMD419ScreenRAM[offset+1]));
+        SPI.transfer(DMD419_RAM_TO_WIRE(bDMD419ScreenRAM[offset+2+row3]));    
+        SPI.transfer(DMD419_RAM_TO_WIRE(bDMD419ScreenRAM[offset+2+row2]));
+        SPI.transfer(DMD419_RAM_TO_WIRE(bDMD419ScreenRAM[offset+3+row3]));
+        SPI.transfer(DMD419_RAM_TO_WIRE(bDMD419ScreenRAM[offset+3+row2]));
+        SPI.transfer(DMD419_RAM_TO_WIRE(bDMD419ScreenRAM[offset+2+row1]));
+        SPI.transfer(DMD419_RAM_TO_WIRE(bDMD419ScreenRAM[offset+2]));
+        SPI.transfer(DMD419_RAM_TO_WIRE(bDMD419ScreenRAM[offset+3+row1]));
+        SPI.transfer(DMD419_RAM_TO_WIRE(bDMD419ScreenRAM[offset+3]));
+        offset += 4;    // the next panel's bytes of the same rows
     }
+
+    OE_DMD419_ROWS_OFF();
+    LATCH_DMD419_SHIFT_REG_TO_OUTPUT();
+    switch (bDMD419Byte) {
+    case 0:			// row 1, 5, 9, 13 were clocked out
+        LIGHT_DMD419_ROW_01_05_09_13();
+        bDMD419Byte=1;
+        break;
+    case 1:			// row 2, 6, 10, 14 were clocked out
+        LIGHT_DMD419_ROW_02_06_10_14();
+        bDMD419Byte=2;
+        break;
+    case 2:			// row 3, 7, 11, 15 were clocked out
+        LIGHT_DMD419_ROW_03_07_11_15();
+        bDMD419Byte=3;
+        break;
+    case 3:			// row 4, 8, 12, 16 were clocked out
+        LIGHT_DMD419_ROW_04_08_12_16();
+        bDMD419Byte=0;
+        break;
+    }
+    OE_DMD419_ROWS_ON();
+}
+
+void DMD419::scanPending(void *display)
+{
+    ((DMD419 *)display)->scanPhase();
+}
+
+boolean DMD419::deferScan(void *display, void (*phase)(void *))
+{
+    if (pendingScan != 0) return false;
+    pendingScanPhase = phase;
+    pendingScan = display;
+    return true;
+}
+
+/*--------------------------------------------------------------------------------------
+ Take the SPI bus for another device. The scan interrupt will not touch SPI until the
+ matching unlockSPI(). The DMD419 SPI settings are saved here and restored on release.
+--------------------------------------------------------------------------------------*/
+void DMD419::lockSPI()
+{
+    byte sreg = SREG;
+    noInterrupts();
+    if (spiLockDepth++ == 0) {
+        savedSPCR = SPCR;
+        savedSPSR = SPSR;
+    }
+    SREG = sreg;
+}
+
+/*--------------------------------------------------------------------------------------
+ Release the SPI bus. When the last lock is released, the DMD419 SPI settings are restored
+ and a scan that was requested in the meantime runs immediately. The pending scan is taken
+ with interrupts off, but runs with them restored; the bus stays locked while it runs, so a
+ timer driven scan in between is deferred again (and run next) instead of interleaving.
+--------------------------------------------------------------------------------------*/
+void DMD419::unlockSPI()
+{
+    byte sreg = SREG;
+    noInterrupts();
+    if (spiLockDepth == 0 || --spiLockDepth != 0) {
+        SREG = sreg;
+        return;
+    }
+    SPCR = savedSPCR;
+    SPSR = savedSPSR;
+    for (;;) {
+        void *display = pendingScan;
+        void (*phase)(void *) = pendingScanPhase;
+        pendingScan = 0;
+        if (display == 0) break;
+        spiLockDepth = 1;
+        SREG = sreg;
+        phase(display);
+        noInterrupts();
+        spiLockDepth = 0;
+    }
+    SREG = sreg;
+}
+
+void DMD419::scanCounts(unsigned long &deferred, unsigned long &skipped)
+{
+    byte sreg = SREG;
+    noInterrupts();
+    deferred = deferredScans;
+    skipped = skippedScans;
+    SREG = sreg;
 }
 
 void DMD419::selectFont(const uint8_t * font)
 {
     this->Font = font;
+
+    if (pgm_read_byte(font + FONT_LENGTH) == 0
+	    && pgm_read_byte(font + FONT_LENGTH + 1) == 0) return;	// fixed width, offsets are computed
+
+    // variable width font, index it now rather than on the first drawChar()
+    if (font != glyphIndexFont) buildGlyphIndex(font);
+}
+
+//Sum of the widths of all glyphs before glyph (0 based) of a variable width font
+uint16_t DMD419::glyphWidthSum(const uint8_t* font, byte glyph)
+{
+    if (font != glyphIndexFont) buildGlyphIndex(font);
+    uint16_t sum = glyphIndex[glyph / GLYPH_INDEX_STRIDE];
+    for (byte i = glyph & ~(GLYPH_INDEX_STRIDE - 1); i < glyph; i++) {
+	    sum += pgm_read_byte(font + FONT_WIDTH_TABLE + i);
+    }
+    return sum;
 }
 
 
 int DMD419::drawChar(const int bX, const int bY, const unsigned char letter, byte bGraphicsMode)
 {
-    if (bX > (DMD419_PIXELS_ACROSS*DisplaysWide) || bY > (DMD419_PIXELS_DOWN*DisplaysHigh) ) return -1;
+    return drawGlyph(canvas(), this->Font, bX, bY, letter, bGraphicsMode);
+}
+
+/*--------------------------------------------------------------------------------------
+ Draw one character of font (drawChar(), drawString(), DMD419T)
+--------------------------------------------------------------------------------------*/
+int DMD419::drawGlyph(const DMD419Canvas &cv, const uint8_t *font, int bX, int bY,
+		   unsigned char letter, byte bGraphicsMode)
+{
+    int screenWide = DMD419_PIXELS_ACROSS * cv.displaysWide;
+    int screenHigh = DMD419_PIXELS_DOWN * cv.displaysHigh;
+    if (bX > screenWide || bY > screenHigh) return -1;
     unsigned char c = letter;
-    uint8_t height = pgm_read_byte(this->Font + FONT_HEIGHT);
+    uint8_t height = pgm_read_byte(font + FONT_HEIGHT);
     if (c == ' ') {
-	    int charWide = charWidth(' ');
-	    this->drawFilledBox(bX, bY, bX + charWide, bY + height, GRAPHICS_INVERSE);
+	    int charWide = fontCharWidth(font, ' ');
+	    if (bGraphicsMode != GRAPHICS_TRANSPARENT)
+	        fillBox(cv, bX, bY, bX + charWide, bY + height, GRAPHICS_INVERSE);
 	    return charWide;
     }
     uint8_t width = 0;
     uint8_t bytes = (height + 7) / 8;
 
-    uint8_t firstChar = pgm_read_byte(this->Font + FONT_FIRST_CHAR);
-    uint8_t charCount = pgm_read_byte(this->Font + FONT_CHAR_COUNT);
+    uint8_t firstChar = pgm_read_byte(font + FONT_FIRST_CHAR);
+    uint8_t charCount = pgm_read_byte(font + FONT_CHAR_COUNT);
 
     uint16_t index = 0;
 
     if (c < firstChar || c >= (firstChar + charCount)) return 0;
     c -= firstChar;
 
-    if (pgm_read_byte(this->Font + FONT_LENGTH) == 0
-	    && pgm_read_byte(this->Font + FONT_LENGTH + 1) == 0) {
+    if (pgm_read_byte(font + FONT_LENGTH) == 0
+	    && pgm_read_byte(font + FONT_LENGTH + 1) == 0) {
 	    // zero length is flag indicating fixed width font (array does not contain width data entries)
-	    width = pgm_read_byte(this->Font + FONT_FIXED_WIDTH);
+	    width = pgm_read_byte(font + FONT_FIXED_WIDTH);
 	    index = c * bytes * width + FONT_WIDTH_TABLE;
     } else {
-	    // variable width font, read width data, to get the index
-	    for (uint8_t i = 0; i < c; i++) {
-	        index += pgm_read_byte(this->Font + FONT_WIDTH_TABLE + i);
-	    }
-	    index = index * bytes + charCount + FONT_WIDTH_TABLE;
-	    width = pgm_read_byte(this->Font + FONT_WIDTH_TABLE + c);
+	    // variable width font, the glyph index built by selectFont() gives the offset
+	    index = glyphWidthSum(font, c) * bytes + charCount + FONT_WIDTH_TABLE;
+	    width = pgm_read_byte(font + FONT_WIDTH_TABLE + c);
     }
     if (bX < -width || bY < -height) return width;
 
     // last but not least, draw the character
-    for (uint8_t j = 0; j < width; j++) { // Width
-	    for (uint8_t i = bytes - 1; i < 254; i--) { // Vertical Bytes
-	        uint8_t data = pgm_read_byte(this->Font + index + j + (i * width));
-		    int offset = (i * 8);
-		    if ((i == bytes - 1) && bytes > 1) {
-		        offset = height - 8;
-            }
-	        for (uint8_t k = 0; k < 8; k++) { // Vertical bits
-		        if ((offset+k >= i*8) && (offset+k <= height)) {
-		            if (data & (1 << k)) {
-			            writePixel(bX + j, bY + offset + k, bGraphicsMode, true);
-		            } else {
-			            writePixel(bX + j, bY + offset + k, bGraphicsMode, false);
-		            }
+    // the glyph is clipped to the screen once, then each font column byte is walked down the
+    // RAM a row stride at a time instead of going through writePixel() for every bit
+    int rowsize = (cv.displaysWide * cv.displaysHigh)<<2;
+    int runBytes = cv.displaysWide<<2;
+    int jFrom = (bX < 0) ? -bX : 0;
+    int jTo = (bX + width > screenWide) ? screenWide - bX : width;
+
+    // what a background (zero) bit does: only NORMAL and INVERSE draw the background
+    byte bgMode = 0xFF;
+    if (bGraphicsMode == GRAPHICS_NORMAL) bgMode = GRAPHICS_INVERSE;
+    else if (bGraphicsMode == GRAPHICS_INVERSE) bgMode = GRAPHICS_NORMAL;
+
+    for (uint8_t i = 0; i < bytes; i++) { // Vertical Bytes
+	    // glyph rows covered by this byte, the last byte is aligned to the bottom of the glyph
+	    int first = i * 8;
+	    int offset = ((i == bytes - 1) && bytes > 1) ? height - 8 : first;
+	    int last = (offset + 7 < height) ? offset + 7 : height;
+	    int top = bY + first;
+	    int bottom = bY + last;
+	    if (top < 0) top = 0;
+	    if (bottom >= screenHigh) bottom = screenHigh - 1;
+	    if (top > bottom) continue;
+
+	    byte shift = top - bY - offset;
+	    byte count = bottom - top + 1;
+	    byte *rowStart = cv.ram + (top % DMD419_PIXELS_DOWN) * rowsize + (top / DMD419_PIXELS_DOWN) * runBytes;
+
+	    for (int j = jFrom; j < jTo; j++) { // Width
+	        uint8_t data = pgm_read_byte(font + index + j + (i * width)) >> shift;
+	        int x = bX + j;
+	        byte mask = bPixelLookupTable[x & 0x07];
+	        byte *b = rowStart + (x >> 3);
+	        byte y = top % DMD419_PIXELS_DOWN;
+	        for (byte k = 0; k < count; k++) { // Vertical bits
+		        if (data & 1) {
+		            applySpanMask(b, mask, bGraphicsMode);
+		        } else if (bgMode != 0xFF) {
+		            applySpanMask(b, mask, bgMode);
 		        }
+		        data >>= 1;
+		        nextRow(b, y, true, rowsize, runBytes);
 	        }
 	    }
     }
@@ -533,29 +834,32 @@ int DMD419::drawChar(const int bX, const int bY, const unsigned char letter, byt
 }
 
 int DMD419::charWidth(const unsigned char letter)
+{
+    return fontCharWidth(this->Font, letter);
+}
+
+int DMD419::fontCharWidth(const uint8_t *font, unsigned char letter)
 {
     unsigned char c = letter;
     // Space is often not included in font so use width of 'n'
     if (c == ' ') c = 'n';
     uint8_t width = 0;
 
-    uint8_t firstChar = pgm_read_byte(this->Font + FONT_FIRST_CHAR);
-    uint8_t charCount = pgm_read_byte(this->Font + FONT_CHAR_COUNT);
-
-    uint16_t index = 0;
+    uint8_t firstChar = pgm_read_byte(font + FONT_FIRST_CHAR);
+    uint8_t charCount = pgm_read_byte(font + FONT_CHAR_COUNT);
 
     if (c < firstChar || c >= (firstChar + charCount)) {
 	    return 0;
     }
     c -= firstChar;
 
-    if (pgm_read_byte(this->Font + FONT_LENGTH) == 0
-	&& pgm_read_byte(this->Font + FONT_LENGTH + 1) == 0) {
+    if (pgm_read_byte(font + FONT_LENGTH) == 0
+	&& pgm_read_byte(font + FONT_LENGTH + 1) == 0) {
 	    // zero length is flag indicating fixed width font (array does not contain width data entries)
-	    width = pgm_read_byte(this->Font + FONT_FIXED_WIDTH);
+	    width = pgm_read_byte(font + FONT_FIXED_WIDTH);
     } else {
 	    // variable width font, read width data
-	    width = pgm_read_byte(this->Font + FONT_WIDTH_TABLE + c);
+	    width = pgm_read_byte(font + FONT_WIDTH_TABLE + c);
     }
     return width;
 }
@@ -59,6 +59,7 @@ LED Panel Layout in RAM
 #define PIN_DMD419_R_DATA    11   // D11_MOSI is SPI Master Out if SPI is used
 //Define this chip select pin that the Ethernet W5100 IC or other SPI device uses
 //if it is in use during a DMD419 scan request then scanDisplayBySPI() will exit without conflict! (and skip that scan)
+//Other SPI users should rather wrap their transfers in DMD419::lockSPI()/unlockSPI(), which defers the scan instead
 #define PIN_OTHER_SPI_nCS 10
 // ######################################################################################################################
 // ######################################################################################################################
@@ -78,6 +79,7 @@ LED Panel Layout in RAM
 #define GRAPHICS_TOGGLE    2
 #define GRAPHICS_OR        3
 #define GRAPHICS_NOR       4
+#define GRAPHICS_TRANSPARENT 5   //like GRAPHICS_OR, and drawString()/drawChar() leave the background untouched
 
 //drawTestPattern Patterns
 #define PATTERN_ALT_0     0
@@ -91,6 +93,41 @@ LED Panel Layout in RAM
 #define DMD419_BITSPERPIXEL           1      //1 bit per pixel, use more bits to allow for pwm screen brightness control
 #define DMD419_RAM_SIZE_BYTES        ((DMD419_PIXELS_ACROSS*DMD419_BITSPERPIXEL/8)*DMD419_PIXELS_DOWN)
                                   // (32x * 1 / 8) = 4 bytes, * 16y = 64 bytes per screen here.
+//Screen RAM polarity. This must be a global build flag (-DDMD419_NATIVE_POLARITY=1 for every
+//file, e.g. compiler.cpp.extra_flags in platform.local.txt), not a #define in the sketch: the
+//sketch and DMD419.cpp have to agree, and a build where they don't fails to link.
+// 0: original DMD layout, a zero bit is a lit pixel and every byte is inverted with ~ while scanning
+// 1: RAM holds wire-ready bytes, a one bit is a lit pixel, and the scan sends bytes untouched.
+//    The vma419 driver uses the same bit polarity but a different row order, so frames still
+//    have to be converted row by row to go from one to the other.
+#ifndef DMD419_NATIVE_POLARITY
+#define DMD419_NATIVE_POLARITY 0
+#endif
+
+//Every file that includes DMD419.h references the symbol for its polarity, DMD419.cpp defines
+//only the one it was built with
+#if DMD419_NATIVE_POLARITY
+#define DMD419_POLARITY_CHECK         DMD419_built_with_native_polarity
+#else
+#define DMD419_POLARITY_CHECK         DMD419_built_with_inverted_polarity
+#endif
+extern const byte DMD419_POLARITY_CHECK;
+static const byte * const dmd419PolarityCheck PROGMEM __attribute__((used)) = &DMD419_POLARITY_CHECK;
+
+#if DMD419_NATIVE_POLARITY
+#define DMD419_RAM_ALL_OFF            0x00                      // byte value with all 8 pixels off
+#define DMD419_RAM_PIXEL_ON(b, m)     ((b) |= (m))
+#define DMD419_RAM_PIXEL_OFF(b, m)    ((b) &= ~(m))
+#define DMD419_RAM_IS_ON(b, m)        (((b) & (m)) != 0)
+#define DMD419_RAM_TO_WIRE(b)         (b)
+#else
+#define DMD419_RAM_ALL_OFF            0xFF
+#define DMD419_RAM_PIXEL_ON(b, m)     ((b) &= ~(m))
+#define DMD419_RAM_PIXEL_OFF(b, m)    ((b) |= (m))
+#define DMD419_RAM_IS_ON(b, m)        (((b) & (m)) == 0)
+#define DMD419_RAM_TO_WIRE(b)         ((byte)~(b))                // its own inverse, also wire -> RAM
+#endif
+
 //lookup table for DMD419::writePixel to make the pixel indexing routine faster
 static byte bPixelLookupTable[8] =
 {
@@ -114,6 +151,16 @@ static byte bPixelLookupTable[8] =
 
 typedef uint8_t (*FontCallback)(const uint8_t*);
 
+//Screen RAM and panel geometry the shared drawing code works on (DMD419 and DMD419T)
+struct DMD419Canvas
+{
+    byte *ram;
+    byte displaysWide;
+    byte displaysHigh;
+};
+
+template <byte PanelsWide, byte PanelsHigh, class Pins> class DMD419T;
+
 
 //The main class of DMD419 library functions
 class DMD419
@@ -141,6 +188,13 @@ class DMD419
   //Find the width of a character
   int charWidth(const unsigned char letter);
 
+  //Find the width of a string as drawn by drawString(), one blank column after each character
+  int stringWidth(const char* bChars, byte length);
+
+  //Clear the background drawString() would clear for this string in one byte filled box,
+  //then draw it (and any overlay text) with GRAPHICS_TRANSPARENT
+  void clearStringBand(int bX, int bY, const char* bChars, byte length);
+
   //Draw a scrolling string
   void drawMarquee( const char* bChars, byte length, int left, int top);
 
@@ -170,9 +224,86 @@ class DMD419
   //Insert the calls to this function into the main loop for the highest call rate, or from a timer interrupt
   void scanDisplayBySPI();
 
+  //SPI bus arbitration for other SPI users (Ethernet, SD card, ...).
+  //Call lockSPI() before selecting the other device and unlockSPI() after deselecting it.
+  //A scan requested while the bus is locked is deferred and runs immediately on unlockSPI(),
+  //so that quarter of the panel is never left dark. Calls may be nested.
+  static void lockSPI();
+  static void unlockSPI();
+
+  //Scans postponed until unlockSPI() because the bus was locked, and scans dropped (a deferred
+  //scan was already pending, or PIN_OTHER_SPI_nCS was held low). Both are counted by the scan
+  //interrupt, this copies them with interrupts off.
+  void scanCounts( unsigned long &deferred, unsigned long &skipped );
+
 
   private:
+    //DMD419T draws with the same code and shares the SPI arbitration
+    template <byte PanelsWide, byte PanelsHigh, class Pins> friend class DMD419T;
+
     void drawCircleSub( int cx, int cy, int x, int y, byte bGraphicsMode );
+    void shiftColumns( int amountX );
+    void shiftRows( int amountY );
+    DMD419Canvas canvas() { DMD419Canvas c = { bDMD419ScreenRAM, DisplaysWide, DisplaysHigh }; return c; }
+
+    //Drawing on any screen RAM and geometry, shared with DMD419T
+    static void fillBox( const DMD419Canvas &c, int x1, int y1, int x2, int y2, byte bGraphicsMode );
+    static void fillRowSpan( const DMD419Canvas &c, int y, int x1, int x2, byte bGraphicsMode );
+    static void applySpanMask( byte *b, byte mask, byte bGraphicsMode );
+    static int drawGlyph( const DMD419Canvas &c, const uint8_t* font, int bX, int bY, unsigned char letter, byte bGraphicsMode );
+    static void drawText( const DMD419Canvas &c, const uint8_t* font, int bX, int bY, const char* bChars, byte length, byte bGraphicsMode );
+    static int fontCharWidth( const uint8_t* font, unsigned char letter );
+    static void nextRow( byte *&row, byte &bY, boolean forward, int rowsize, int runBytes );
+    static uint16_t glyphWidthSum( const uint8_t* font, byte glyph );
+
+    //Bresenham line through the display's writePixel()
+    template <class Display>
+    static void drawLineOn( Display &display, int x1, int y1, int x2, int y2, byte bGraphicsMode )
+    {
+        int dy = y2 - y1;
+        int dx = x2 - x1;
+        int stepx, stepy;
+
+        if (dy < 0) {
+            dy = -dy;
+            stepy = -1;
+        } else {
+            stepy = 1;
+        }
+        if (dx < 0) {
+            dx = -dx;
+            stepx = -1;
+        } else {
+            stepx = 1;
+        }
+        dy <<= 1;			// dy is now 2*dy
+        dx <<= 1;			// dx is now 2*dx
+
+        display.writePixel(x1, y1, bGraphicsMode, true);
+        if (dx > dy) {
+            int fraction = dy - (dx >> 1);	// same as 2*dy - dx
+            while (x1 != x2) {
+                if (fraction >= 0) {
+                    y1 += stepy;
+                    fraction -= dx;	// same as fraction -= 2*dx
+                }
+                x1 += stepx;
+                fraction += dy;	// same as fraction -= 2*dy
+                display.writePixel(x1, y1, bGraphicsMode, true);
+            }
+        } else {
+            int fraction = dx - (dy >> 1);
+            while (y1 != y2) {
+                if (fraction >= 0) {
+                    x1 += stepx;
+                    fraction -= dy;
+                }
+                y1 += stepy;
+                fraction += dx;
+                display.writePixel(x1, y1, bGraphicsMode, true);
+            }
+        }
+    }
 
 
 
@@ -196,6 +327,24 @@ class DMD419
     //scanning pointer into bDMD419ScreenRAM, setup init @ 48 for the first valid scan
     volatile byte bDMD419Byte;
 
+    //read with scanCounts()
+    volatile unsigned long deferredScans;
+    volatile unsigned long skippedScans;
+
+    //Output one phase; the caller has checked that the SPI bus is free
+    void scanPhase();
+    static void scanPending( void *display );
+
+    //SPI arbitration state shared by all displays on the bus (DMD419 and DMD419T)
+    static volatile byte spiLockDepth;
+    static void * volatile pendingScan;             //display whose scan waits for unlockSPI()
+    static void (* volatile pendingScanPhase)(void *);   //and how to run it
+    static byte savedSPCR, savedSPSR;
+
+    //Called by a scan that found the bus locked, from the scan interrupt: queue it for
+    //unlockSPI(), false if another scan is already waiting
+    static boolean deferScan( void *display, void (*phase)(void *) );
+
 };
 
 #endif /* DMD419_H_ */
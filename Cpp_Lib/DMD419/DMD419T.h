@@ -0,0 +1,282 @@
+/*--------------------------------------------------------------------------------------
+
+ DMD419T.h - Compile-time geometry version of the DMD419 library
+
+ DMD419T<PanelsWide, PanelsHigh, Pins> drives the same 32 x 16 panels with the same RAM
+ layout and SPI byte order as DMD419, but the panel geometry is a template parameter:
+
+ - row1/row2/row3, the row stride and the RAM size are compile time constants
+ - the screen RAM is a member array instead of a malloc'd block
+ - writePixel() uses shifts and constant multiplies instead of run time multiplies
+ - scanDisplayBySPI() is fully unrolled for the number of panels in the chain
+
+ Lines, filled boxes, characters and strings are drawn by the same code as DMD419 (byte wide
+ fills, the glyph index, GRAPHICS_TRANSPARENT), and the scan takes part in DMD419::lockSPI().
+
+ Usage:
+   DMD419T<2, 1> dmd;               // two panels side by side, default pins
+   dmd.scanDisplayBySPI();          // from the TimerOne interrupt, exactly as DMD419
+
+ Pin traits: pass a struct with the same static members as DMD419DefaultPins to drive
+ the A/B/SCLK/nOE lines from other pins. SPI always uses the hardware SPI pins.
+
+ See examples/dmd_template_bench for a cycle comparison against the DMD419 class.
+
+ ---
+
+ This program is free software: you can redistribute it and/or modify it under the terms
+ of the version 3 GNU General Public License as published by the Free Software Foundation.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ See the GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License along with this program.
+ If not, see <http://www.gnu.org/licenses/>.
+
+--------------------------------------------------------------------------------------*/
+#ifndef DMD419T_H_
+#define DMD419T_H_
+
+#include "DMD419.h"
+
+//Default pin traits, the same pins the DMD419 class uses
+struct DMD419DefaultPins
+{
+    static const uint8_t nOE         = PIN_DMD419_nOE;
+    static const uint8_t A           = PIN_DMD419_A;
+    static const uint8_t B           = PIN_DMD419_B;
+    static const uint8_t SCLK        = PIN_DMD419_SCLK;
+    static const uint8_t OtherSPInCS = PIN_OTHER_SPI_nCS;
+};
+
+//Tag type used to unroll the per panel SPI sequence at compile time
+template <byte N> struct DMD419PanelCount {};
+
+template <byte PanelsWide, byte PanelsHigh, class Pins = DMD419DefaultPins>
+class DMD419T
+{
+  public:
+    //Geometry, all known at compile time
+    static const byte DisplaysWide  = PanelsWide;
+    static const byte DisplaysHigh  = PanelsHigh;
+    static const byte DisplaysTotal = PanelsWide * PanelsHigh;
+    static const unsigned int PixelsWide = DMD419_PIXELS_ACROSS * PanelsWide;
+    static const unsigned int PixelsHigh = DMD419_PIXELS_DOWN * PanelsHigh;
+    static const unsigned int RowSize    = DisplaysTotal << 2;     //bytes per pixel row across the chain
+    static const unsigned int RamSize    = DMD419_RAM_SIZE_BYTES * DisplaysTotal;
+    static const unsigned int row1 = DisplaysTotal << 4;
+    static const unsigned int row2 = DisplaysTotal << 5;
+    static const unsigned int row3 = ((DisplaysTotal << 2) * 3) << 2;
+
+    //Mirror of DMD419 pixels in RAM, ready to be clocked out by the main loop or high speed timer calls
+    byte bDMD419ScreenRAM[RamSize];
+
+    DMD419T() : Font(0), bDMD419Byte(0), deferredScans(0), skippedScans(0)
+    {
+        SPI.begin();
+        SPI.setBitOrder(MSBFIRST);
+        SPI.setDataMode(SPI_MODE0);
+        SPI.setClockDivider(SPI_CLOCK_DIV4);
+
+        digitalWrite(Pins::A, LOW);
+        digitalWrite(Pins::B, LOW);
+        digitalWrite(PIN_DMD419_CLK, LOW);
+        digitalWrite(Pins::SCLK, LOW);
+        digitalWrite(PIN_DMD419_R_DATA, HIGH);
+        digitalWrite(Pins::nOE, LOW);
+
+        pinMode(Pins::A, OUTPUT);
+        pinMode(Pins::B, OUTPUT);
+        pinMode(PIN_DMD419_CLK, OUTPUT);
+        pinMode(Pins::SCLK, OUTPUT);
+        pinMode(PIN_DMD419_R_DATA, OUTPUT);
+        pinMode(Pins::nOE, OUTPUT);
+
+        clearScreen(true);
+    }
+
+    /*--------------------------------------------------------------------------------------
+     Set or clear a pixel at the x and y location (0,0 is the top left corner)
+     Same semantics as DMD419::writePixel, all divisions are by constant powers of two
+    --------------------------------------------------------------------------------------*/
+    void writePixel(unsigned int bX, unsigned int bY, byte bGraphicsMode, byte bPixel)
+    {
+        if (bX >= PixelsWide || bY >= PixelsHigh) {
+            return;
+        }
+        byte panel = (bX / DMD419_PIXELS_ACROSS) + (DisplaysWide * (bY / DMD419_PIXELS_DOWN));
+        bX = (bX % DMD419_PIXELS_ACROSS) + (panel << 5);
+        bY = bY % DMD419_PIXELS_DOWN;
+        byte *ram = &bDMD419ScreenRAM[bX / 8 + bY * RowSize];
+        byte lookup = bPixelLookupTable[bX & 0x07];
+
+        switch (bGraphicsMode) {
+        case GRAPHICS_NORMAL:
+            if (bPixel == true)
+                DMD419_RAM_PIXEL_ON(*ram, lookup);
+            else
+                DMD419_RAM_PIXEL_OFF(*ram, lookup);
+            break;
+        case GRAPHICS_INVERSE:
+            if (bPixel == false)
+                DMD419_RAM_PIXEL_ON(*ram, lookup);
+            else
+                DMD419_RAM_PIXEL_OFF(*ram, lookup);
+            break;
+        case GRAPHICS_TOGGLE:
+            if (bPixel == true)
+                *ram ^= lookup;
+            break;
+        case GRAPHICS_OR:
+        case GRAPHICS_TRANSPARENT:
+            //only set pixels on
+            if (bPixel == true)
+                DMD419_RAM_PIXEL_ON(*ram, lookup);
+            break;
+        case GRAPHICS_NOR:
+            //only clear on pixels
+            if (bPixel == true)
+                DMD419_RAM_PIXEL_OFF(*ram, lookup);
+            break;
+        }
+    }
+
+    /*--------------------------------------------------------------------------------------
+     Clear the screen in DMD419 RAM
+    --------------------------------------------------------------------------------------*/
+    void clearScreen(byte bNormal)
+    {
+        memset(bDMD419ScreenRAM, bNormal ? DMD419_RAM_ALL_OFF : (byte)~DMD419_RAM_ALL_OFF, RamSize);
+    }
+
+    //Draw or clear a line from x1,y1 to x2,y2
+    void drawLine(int x1, int y1, int x2, int y2, byte bGraphicsMode)
+    {
+        DMD419::drawLineOn(*this, x1, y1, x2, y2, bGraphicsMode);
+    }
+
+    //Draw or clear a filled box(rectangle), a byte at a time
+    void drawFilledBox(int x1, int y1, int x2, int y2, byte bGraphicsMode)
+    {
+        DMD419::fillBox(canvas(), x1, y1, x2, y2, bGraphicsMode);
+    }
+
+    //Select a text font
+    void selectFont(const uint8_t *font)
+    {
+        Font = font;
+    }
+
+    //Find the width of a character
+    int charWidth(const unsigned char letter)
+    {
+        return DMD419::fontCharWidth(Font, letter);
+    }
+
+    //Draw a single character, same as DMD419::drawChar
+    int drawChar(const int bX, const int bY, const unsigned char letter, byte bGraphicsMode)
+    {
+        return DMD419::drawGlyph(canvas(), Font, bX, bY, letter, bGraphicsMode);
+    }
+
+    //Draw a string, same as DMD419::drawString
+    void drawString(int bX, int bY, const char *bChars, byte length, byte bGraphicsMode)
+    {
+        DMD419::drawText(canvas(), Font, bX, bY, bChars, length, bGraphicsMode);
+    }
+
+    /*--------------------------------------------------------------------------------------
+     Scan the dot matrix LED panel display, from the RAM mirror out to the display hardware.
+     Call 4 times to scan the whole display which is made up of 4 interleaved rows within the 16 total rows.
+     Bus locking and skipping work exactly like DMD419::scanDisplayBySPI.
+    --------------------------------------------------------------------------------------*/
+    void scanDisplayBySPI()
+    {
+        if (DMD419::spiLockDepth != 0) {
+            //another SPI user holds the bus: run this scan as soon as it calls unlockSPI()
+            if (DMD419::deferScan(this, scanPending)) {
+                deferredScans++;
+            } else {
+                skippedScans++;
+            }
+            return;
+        }
+        if (digitalRead(Pins::OtherSPInCS) == LOW) {
+            skippedScans++;
+            return;
+        }
+        scanPhase();
+    }
+
+    //Deferred and dropped scans, copied with interrupts off (same as DMD419::scanCounts)
+    void scanCounts(unsigned long &deferred, unsigned long &skipped)
+    {
+        byte sreg = SREG;
+        noInterrupts();
+        deferred = deferredScans;
+        skipped = skippedScans;
+        SREG = sreg;
+    }
+
+  private:
+    DMD419Canvas canvas() { DMD419Canvas c = { bDMD419ScreenRAM, DisplaysWide, DisplaysHigh }; return c; }
+
+    //Output one phase, the per panel byte sequence is unrolled DisplaysTotal times at compile time
+    void scanPhase()
+    {
+        scanPanels(&bDMD419ScreenRAM[RowSize * bDMD419Byte], DMD419PanelCount<DisplaysTotal>());
+
+        digitalWrite(Pins::nOE, LOW);           // OE_DMD419_ROWS_OFF
+        digitalWrite(Pins::SCLK, HIGH);         // LATCH_DMD419_SHIFT_REG_TO_OUTPUT
+        digitalWrite(Pins::SCLK, LOW);
+        digitalWrite(Pins::B, (bDMD419Byte & 0x02) ? HIGH : LOW);
+        digitalWrite(Pins::A, (bDMD419Byte & 0x01) ? HIGH : LOW);
+        bDMD419Byte = (bDMD419Byte + 1) & 0x03;
+        digitalWrite(Pins::nOE, HIGH);          // OE_DMD419_ROWS_ON
+    }
+
+    static void scanPending(void *display)
+    {
+        static_cast<DMD419T *>(display)->scanPhase();
+    }
+
+    //End of the unrolled panel sequence
+    __attribute__((always_inline)) inline void scanPanels(const byte *, DMD419PanelCount<0>) {}
+
+    //One panel's 16 bytes in the DMD419 order, then the next panel's bytes of the same rows,
+    //4 bytes further on (as DMD419::scanPhase and the vma419 driver)
+    template <byte N>
+    __attribute__((always_inline)) inline void scanPanels(const byte *p, DMD419PanelCount<N>)
+    {
+        SPI.transfer(DMD419_RAM_TO_WIRE(p[0 + row3]));
+        SPI.transfer(DMD419_RAM_TO_WIRE(p[0 + row2]));
+        SPI.transfer(DMD419_RAM_TO_WIRE(p[1 + row3]));
+        SPI.transfer(DMD419_RAM_TO_WIRE(p[1 + row2]));
+        SPI.transfer(DMD419_RAM_TO_WIRE(p[0 + row1]));
+        SPI.transfer(DMD419_RAM_TO_WIRE(p[0]));
+        SPI.transfer(DMD419_RAM_TO_WIRE(p[1 + row1]));
+        SPI.transfer(DMD419_RAM_TO_WIRE(p[1]));
+        SPI.transfer(DMD419_RAM_TO_WIRE(p[2 + row3]));
+        SPI.transfer(DMD419_RAM_TO_WIRE(p[2 + row2]));
+        SPI.transfer(DMD419_RAM_TO_WIRE(p[3 + row3]));
+        SPI.transfer(DMD419_RAM_TO_WIRE(p[3 + row2]));
+        SPI.transfer(DMD419_RAM_TO_WIRE(p[2 + row1]));
+        SPI.transfer(DMD419_RAM_TO_WIRE(p[2]));
+        SPI.transfer(DMD419_RAM_TO_WIRE(p[3 + row1]));
+        SPI.transfer(DMD419_RAM_TO_WIRE(p[3]));
+        scanPanels(p + 4, DMD419PanelCount<N - 1>());
+    }
+
+    //Pointer to current font
+    const uint8_t *Font;
+
+    //scanning phase 0..3
+    volatile byte bDMD419Byte;
+
+    //read with scanCounts()
+    volatile unsigned long deferredScans;
+    volatile unsigned long skippedScans;
+};
+
+#endif /* DMD419T_H_ */
@@ -0,0 +1,97 @@
+/*--------------------------------------------------------------------------------------
+
+ dmd_template_bench.ino
+   Cycle comparison between the run time geometry DMD419 class and the compile time
+   geometry DMD419T<PanelsWide, PanelsHigh> template.
+
+ Both objects drive the same panels, so only run the scans while the other one is idle.
+ Timer1 is not used here; every measurement is a busy loop timed with micros(), and the
+ results are printed in CPU cycles per call on the serial monitor (115200 baud).
+
+ Compare the "pixel" and "scan" lines of both classes: the template removes the run time
+ multiplies from writePixel() and the loop/offset arithmetic from scanDisplayBySPI().
+
+ This example code is in the public domain.
+
+--------------------------------------------------------------------------------------*/
+#include <SPI.h>
+#include <DMD419.h>
+#include <DMD419T.h>
+
+#define DISPLAYS_ACROSS 2
+#define DISPLAYS_DOWN 1
+#define ITERATIONS 1000
+
+DMD419 dmd(DISPLAYS_ACROSS, DISPLAYS_DOWN);
+DMD419T<DISPLAYS_ACROSS, DISPLAYS_DOWN> dmdT;
+
+//Convert a micros() interval for ITERATIONS calls into cycles per call
+static unsigned long cyclesPerCall(unsigned long elapsedMicros)
+{
+  return (elapsedMicros * (F_CPU / 1000000UL)) / ITERATIONS;
+}
+
+static void report(const char *what, unsigned long runtimeCycles, unsigned long templateCycles)
+{
+  Serial.print(what);
+  Serial.print(": DMD419 ");
+  Serial.print(runtimeCycles);
+  Serial.print(" cycles, DMD419T ");
+  Serial.print(templateCycles);
+  Serial.println(" cycles");
+}
+
+void setup(void)
+{
+  Serial.begin(115200);
+  unsigned long start, runtimeCycles, templateCycles;
+
+  //per pixel: writePixel() over a diagonal so every panel and byte offset is used
+  start = micros();
+  for (unsigned int i = 0; i < ITERATIONS; i++) {
+    dmd.writePixel(i % (32 * DISPLAYS_ACROSS), i % (16 * DISPLAYS_DOWN), GRAPHICS_NORMAL, i & 1);
+  }
+  runtimeCycles = cyclesPerCall(micros() - start);
+
+  start = micros();
+  for (unsigned int i = 0; i < ITERATIONS; i++) {
+    dmdT.writePixel(i % (32 * DISPLAYS_ACROSS), i % (16 * DISPLAYS_DOWN), GRAPHICS_NORMAL, i & 1);
+  }
+  templateCycles = cyclesPerCall(micros() - start);
+  report("pixel", runtimeCycles, templateCycles);
+
+  //per scan: one quarter of the display, including the SPI transfers
+  start = micros();
+  for (unsigned int i = 0; i < ITERATIONS; i++) {
+    dmd.scanDisplayBySPI();
+  }
+  runtimeCycles = cyclesPerCall(micros() - start);
+
+  start = micros();
+  for (unsigned int i = 0; i < ITERATIONS; i++) {
+    dmdT.scanDisplayBySPI();
+  }
+  templateCycles = cyclesPerCall(micros() - start);
+  report("scan", runtimeCycles, templateCycles);
+
+  //clear screen, for reference
+  start = micros();
+  for (unsigned int i = 0; i < ITERATIONS; i++) {
+    dmd.clearScreen(true);
+  }
+  runtimeCycles = cyclesPerCall(micros() - start);
+
+  start = micros();
+  for (unsigned int i = 0; i < ITERATIONS; i++) {
+    dmdT.clearScreen(true);
+  }
+  templateCycles = cyclesPerCall(micros() - start);
+  report("clear", runtimeCycles, templateCycles);
+}
+
+void loop(void)
+{
+  //keep the template instance refreshing the panels so the result is visible
+  dmdT.scanDisplayBySPI();
+  delayMicroseconds(1000);
+}
@@ -350,8 +350,8 @@ static inline uint8_t vma419_font_draw_char(VMA419_Display* disp, int16_t x, int
         return 0; // Character not available
     }
     
-    // Check bounds
-    if (x >= 32 || y >= 16) return 0;
+    // Check bounds (the whole display, however many panels)
+    if (x >= (int16_t)disp->total_width_pixels || y >= (int16_t)disp->total_height_pixels) return 0;
     if ((x + VMA419_FONT_WIDTH) < 0 || (y + VMA419_FONT_HEIGHT) < 0) return VMA419_FONT_WIDTH;
     
     // Calculate character index and data offset
@@ -361,14 +361,14 @@ static inline uint8_t vma419_font_draw_char(VMA419_Display* disp, int16_t x, int
     // Draw character column by column
     for (uint8_t col = 0; col < VMA419_FONT_WIDTH; col++) {
         int16_t pixel_x = x + col;
-        if (pixel_x >= 0 && pixel_x < 32) {
+        if (pixel_x >= 0 && pixel_x < (int16_t)disp->total_width_pixels) {
             // Read column data from PROGMEM
             uint8_t column_data = pgm_read_byte(&vma419_font_5x7[data_offset + col]);
             
             // Draw pixels in this column
             for (uint8_t row = 0; row < VMA419_FONT_HEIGHT; row++) {
                 int16_t pixel_y = y + row;
-                if (pixel_y >= 0 && pixel_y < 16) {
+                if (pixel_y >= 0 && pixel_y < (int16_t)disp->total_height_pixels) {
                     if (column_data & (1 << row)) {
                         vma419_set_pixel(disp, pixel_x, pixel_y, 1);
                     }
@@ -392,7 +392,7 @@ static inline void vma419_font_draw_string(VMA419_Display* disp, int16_t x, int1
     
     int16_t cursor_x = x;
     
-    while (*str && cursor_x < 32) {
+    while (*str && cursor_x < (int16_t)disp->total_width_pixels) {
         uint8_t char_width = vma419_font_draw_char(disp, cursor_x, y, *str);
         cursor_x += char_width + 1; // Add 1 pixel spacing between characters
         str++;
@@ -433,7 +433,7 @@ static inline void vma419_font_draw_number_2d(VMA419_Display* disp, int16_t x, i
  * @param str String to center
  */
 static inline void vma419_font_draw_string_centered(VMA419_Display* disp, int16_t y, const char* str) {
-    if (!str) return;
+    if (!disp || !str) return;
     
     // Calculate string width
     uint8_t len = 0;
@@ -441,10 +441,10 @@ static inline void vma419_font_draw_string_centered(VMA419_Display* disp, int16_
     while (*p++) len++;
     
     // Calculate total pixel width: (chars * 5) + (spaces * 1)
-    uint8_t total_width = (len * VMA419_FONT_WIDTH) + (len - 1);
+    int16_t total_width = (len * VMA419_FONT_WIDTH) + (len - 1);
     
-    // Center the string
-    int16_t start_x = (32 - total_width) / 2;
+    // Center the string on the whole display
+    int16_t start_x = ((int16_t)disp->total_width_pixels - total_width) / 2;
     if (start_x < 0) start_x = 0;
     
     vma419_font_draw_string(disp, start_x, y, str);
@@ -0,0 +1,196 @@
+/*
+ * VMA419_FontCreator.h - Proportional Fonts for the VMA419 Display
+ *
+ * Draws text with the FontCreator fonts of the DMD419 library
+ * (Cpp_Lib/DMD419/Arial14.h, Arial_black_16.h, SystemFont5x7.h, ...) from
+ * plain C. Every character takes only as many columns as it needs, so far
+ * more text fits on the panel than with a fixed 6 pixels per character.
+ *
+ * FontCreator format (all in PROGMEM):
+ *   size (2 bytes, 0 = fixed width font), fixed width, height,
+ *   first char, char count,
+ *   widths[char count]         only in variable width fonts
+ *   glyph data                 per glyph: (height+7)/8 rows of 'width' column
+ *                              bytes, bit 0 = top; the last byte row is
+ *                              aligned to the bottom of the glyph
+ *
+ * Finding a glyph in a variable width font needs the sum of the widths of
+ * all glyphs before it. Like DMD419::selectFont(), vma419_fc_select() keeps
+ * that sum for every VMA419_FC_INDEX_STRIDE'th glyph, so a lookup reads at
+ * most STRIDE-1 widths instead of up to 223.
+ *
+ * Measuring text walks the width table, so measure once when the text
+ * changes and keep the result (main.c keeps scroll_text_width).
+ *
+ * Usage:
+ *   #include "VMA419_FontCreator.h"
+ *   #include "Cpp_Lib/DMD419/Arial14.h"
+ *   VMA419_FCFont font;
+ *   vma419_fc_select(&font, Arial_14);
+ *   uint16_t width = vma419_fc_string_width(&font, "Hello");
+ *   vma419_fc_draw_string(&display, &font, x, y, "Hello");
+ *
+ */
+
+#ifndef VMA419_FONTCREATOR_H
+#define VMA419_FONTCREATOR_H
+
+#include <avr/pgmspace.h>
+#include <stdint.h>
+#include "vma419.h"
+
+#ifndef VMA419_FC_INDEX_STRIDE
+#define VMA419_FC_INDEX_STRIDE 16   // Glyphs per index entry (power of 2); smaller = faster, more RAM
+#endif
+#define VMA419_FC_INDEX_ENTRIES (256 / VMA419_FC_INDEX_STRIDE)
+
+// Byte positions in the font header
+#define VMA419_FC_LENGTH      0
+#define VMA419_FC_FIXED_WIDTH 2
+#define VMA419_FC_HEIGHT      3
+#define VMA419_FC_FIRST_CHAR  4
+#define VMA419_FC_CHAR_COUNT  5
+#define VMA419_FC_WIDTH_TABLE 6
+
+typedef struct {
+    const uint8_t* data;            // The PROGMEM font array
+    uint8_t height;
+    uint8_t first_char;
+    uint8_t char_count;
+    uint8_t fixed_width;            // 0 = variable width font
+    uint8_t bytes_per_column;       // (height + 7) / 8
+    uint8_t space_width;            // Width of 'n', used for ' ' (DMD419 does the same)
+    uint16_t index[VMA419_FC_INDEX_ENTRIES];    // Width sum before every STRIDE'th glyph
+} VMA419_FCFont;
+
+//==============================================================================
+// FONT SELECTION AND METRICS
+//==============================================================================
+
+// Width of a glyph as stored in the font (no space substitution)
+static inline uint8_t vma419_fc_glyph_width(const VMA419_FCFont* f, uint8_t c) {
+    if (c < f->first_char || c - f->first_char >= f->char_count) return 0;
+    if (f->fixed_width) return f->fixed_width;
+    return pgm_read_byte(f->data + VMA419_FC_WIDTH_TABLE + (c - f->first_char));
+}
+
+/**
+ * Use a FontCreator font (reads the header and builds the glyph index)
+ * @param f Font state to fill in
+ * @param font PROGMEM font array, e.g. Arial_14
+ */
+static inline void vma419_fc_select(VMA419_FCFont* f, const uint8_t* font) {
+    f->data = font;
+    f->height = pgm_read_byte(font + VMA419_FC_HEIGHT);
+    f->first_char = pgm_read_byte(font + VMA419_FC_FIRST_CHAR);
+    f->char_count = pgm_read_byte(font + VMA419_FC_CHAR_COUNT);
+    f->bytes_per_column = (f->height + 7) / 8;
+    f->fixed_width = 0;
+    if (pgm_read_byte(font + VMA419_FC_LENGTH) == 0 && pgm_read_byte(font + VMA419_FC_LENGTH + 1) == 0) {
+        f->fixed_width = pgm_read_byte(font + VMA419_FC_FIXED_WIDTH);   // Size 0 = fixed width
+    } else {
+        uint16_t sum = 0;
+        for (uint8_t i = 0; i < f->char_count; i++) {
+            if ((i & (VMA419_FC_INDEX_STRIDE - 1)) == 0) f->index[i / VMA419_FC_INDEX_STRIDE] = sum;
+            sum += pgm_read_byte(font + VMA419_FC_WIDTH_TABLE + i);
+        }
+    }
+    f->space_width = vma419_fc_glyph_width(f, 'n');
+}
+
+/**
+ * Width of one character in pixels (without the blank column after it)
+ * @return 0 if the font does not have the character
+ */
+static inline uint8_t vma419_fc_char_width(const VMA419_FCFont* f, uint8_t c) {
+    return (c == ' ') ? f->space_width : vma419_fc_glyph_width(f, c);
+}
+
+/**
+ * Width of a string as vma419_fc_draw_string() draws it: every character
+ * plus one blank column; characters missing from the font take no space
+ */
+static inline uint16_t vma419_fc_string_width(const VMA419_FCFont* f, const char* str) {
+    uint16_t width = 0;
+    while (*str) {
+        uint8_t w = vma419_fc_char_width(f, (uint8_t)*str++);
+        if (w) width += w + 1;
+    }
+    return width;
+}
+
+//==============================================================================
+// DRAWING
+//==============================================================================
+
+// First glyph data byte of character c (which must be in the font)
+static inline const uint8_t* vma419_fc_glyph_data(const VMA419_FCFont* f, uint8_t c) {
+    uint8_t glyph = c - f->first_char;
+    if (f->fixed_width) {
+        return f->data + VMA419_FC_WIDTH_TABLE + (uint16_t)glyph * f->bytes_per_column * f->fixed_width;
+    }
+    uint16_t sum = f->index[glyph / VMA419_FC_INDEX_STRIDE];
+    for (uint8_t i = glyph & ~(VMA419_FC_INDEX_STRIDE - 1); i < glyph; i++) {
+        sum += pgm_read_byte(f->data + VMA419_FC_WIDTH_TABLE + i);
+    }
+    return f->data + VMA419_FC_WIDTH_TABLE + f->char_count + sum * f->bytes_per_column;
+}
+
+/**
+ * Draw one character (only its "on" pixels, like vma419_font_draw_char())
+ * @param disp Pointer to VMA419 display structure
+ * @param f Selected font
+ * @param x X coordinate of the left edge (may be negative)
+ * @param y Y coordinate of the top edge (may be negative)
+ * @param c Character to draw
+ * @return Width of the character (0 if the font does not have it)
+ */
+static inline uint8_t vma419_fc_draw_char(VMA419_Display* disp, const VMA419_FCFont* f, int16_t x, int16_t y, uint8_t c) {
+    uint8_t width = vma419_fc_char_width(f, c);
+    if (!width || c == ' ') return width;
+
+    int16_t screen_w = (int16_t)disp->total_width_pixels;
+    int16_t screen_h = (int16_t)disp->total_height_pixels;
+    if (x >= screen_w || y >= screen_h || x + width <= 0 || y + f->height <= 0) return width;
+
+    const uint8_t* data = vma419_fc_glyph_data(f, c);
+    uint8_t col_from = (x < 0) ? -x : 0;
+    uint8_t col_to = (x + width > screen_w) ? screen_w - x : width;
+
+    for (uint8_t b = 0; b < f->bytes_per_column; b++) {
+        // Glyph rows of this byte row; the last one is aligned to the bottom
+        uint8_t top = (b == f->bytes_per_column - 1 && b > 0) ? f->height - 8 : b * 8;
+
+        for (uint8_t col = col_from; col < col_to; col++) {
+            uint8_t bits = pgm_read_byte(data + b * width + col);
+            for (uint8_t bit = 0; bits; bit++, bits >>= 1) {
+                int16_t pixel_y = y + top + bit;
+                if ((bits & 1) && pixel_y >= 0 && pixel_y < screen_h) {
+                    vma419_set_pixel(disp, x + col, pixel_y, 1);
+                }
+            }
+        }
+    }
+    return width;
+}
+
+/**
+ * Draw a string with one blank column after every character
+ * @param disp Pointer to VMA419 display structure
+ * @param f Selected font
+ * @param x Starting X coordinate (may be negative, for scrolling)
+ * @param y Y coordinate of the top edge
+ * @param str Null-terminated string
+ * @return X coordinate after the last character drawn
+ */
+static inline int16_t vma419_fc_draw_string(VMA419_Display* disp, const VMA419_FCFont* f, int16_t x, int16_t y, const char* str) {
+    if (!disp || !f || !str) return x;
+
+    while (*str && x < (int16_t)disp->total_width_pixels) {
+        uint8_t width = vma419_fc_draw_char(disp, f, x, y, (uint8_t)*str++);
+        if (width) x += width + 1;
+    }
+    return x;
+}
+
+#endif // VMA419_FONTCREATOR_H
@@ -0,0 +1,162 @@
+/*
+ * ambient_light.h - Display Brightness that Follows the Ambient Light
+ *
+ * Outdoors a fixed brightness is too dim at noon and glaring at night. This
+ * reads a light sensor on ADC0 (PA0, not used by the display) and sets the
+ * LED on-time of every scan phase (vma419_set_oe_on_ticks) from it.
+ *
+ * Sensor wiring: photoresistor from AVCC to PA0, 10k from PA0 to GND.
+ * More light gives a higher reading. The divider is roughly logarithmic in
+ * lux, which is also how the eye sees the surroundings.
+ *
+ * How it works, once per main loop pass (about every 4 ms):
+ * 1. The ADC converts in the background while the display scans. The pass
+ *    takes the finished result and starts the next conversion, so there is
+ *    no waiting and no interrupt.
+ * 2. Filter: a running average over about 64 samples (0.25 s) removes
+ *    mains flicker of street lights and sensor noise.
+ * 3. Hysteresis: the level used only follows the average once it is more
+ *    than AMBIENT_LIGHT_HYSTERESIS counts away. Small drifts and a passing
+ *    shadow do not move the brightness back and forth.
+ * 4. Gamma curve (PROGMEM): the level sets the perceived brightness in even
+ *    steps, and the on-time is that brightness to the power 2.2. Dark
+ *    surroundings get very short pulses, where the eye is most sensitive.
+ * 5. Slew limit: the on-time moves at most one tick (4 us) every
+ *    AMBIENT_LIGHT_SLEW_PASSES passes, so changes fade in over seconds
+ *    instead of jumping.
+ * ambient_light_init() waits for one conversion (about 0.4 ms) and uses it
+ * directly, so even the startup logo has the right brightness.
+ *
+ * Without the sensor PA0 floats and the reading is random, so the loop is
+ * off unless AMBIENT_LIGHT_ENABLE is 1 (e.g. -DAMBIENT_LIGHT_ENABLE=1 on a
+ * board with the divider). When off, init and update compile to nothing and
+ * the on-time stays what vma419_set_oe_timing() was given.
+ *
+ * On the PC (host build) the ADC reads whatever host_adc_set_input()
+ * supplies. host/ambient_sim.c runs this loop on recorded or made-up light
+ * levels for tuning.
+ *
+ * Usage:
+ *   #include "ambient_light.h"
+ *   vma419_set_oe_timing(&display, VMA419_OE_PHASE_TICKS, droop, cap);
+ *   ambient_light_init(&display);                // after the line above
+ *   ambient_light_update(&display);              // every main loop pass
+ *
+ */
+
+#ifndef AMBIENT_LIGHT_H
+#define AMBIENT_LIGHT_H
+
+#include <avr/io.h>
+#include <avr/pgmspace.h>
+#include <util/delay.h>
+#include <stdint.h>
+#include "vma419.h"
+
+#ifndef AMBIENT_LIGHT_ENABLE
+#define AMBIENT_LIGHT_ENABLE       0    // 1 = a light sensor is fitted on the channel below
+#endif
+#ifndef AMBIENT_LIGHT_CHANNEL
+#define AMBIENT_LIGHT_CHANNEL      0    // ADC0 = PA0
+#endif
+#ifndef AMBIENT_LIGHT_HYSTERESIS
+#define AMBIENT_LIGHT_HYSTERESIS  16    // ADC counts (of 1023) the average must move first
+#endif
+#ifndef AMBIENT_LIGHT_SLEW_PASSES
+#define AMBIENT_LIGHT_SLEW_PASSES  4    // Main loop passes per 1-tick change (16 ms)
+#endif
+
+#define AMBIENT_LIGHT_FILTER_SHIFT 6    // Running average over 2^6 samples
+
+#if AMBIENT_LIGHT_ENABLE
+
+// On-time in 4 us ticks for sensor levels 0, 32, 64 ... 1024 (interpolated):
+// 2 + 238 * (i / 32)^2.2, from 8 us in the dark to VMA419_OE_PHASE_TICKS
+static const uint8_t ambient_light_curve[33] PROGMEM = {
+      2,   2,   3,   3,   4,   6,   8,  10,  13,  17,  20,  25,  30,  35,  41,  47,
+     54,  61,  69,  78,  87,  96, 106, 117, 128, 140, 153, 166, 179, 194, 208, 224,
+    240
+};
+
+typedef struct {
+    uint16_t sum;                   // 2^AMBIENT_LIGHT_FILTER_SHIFT x the average
+    uint16_t level;                 // Average after hysteresis, 0-1023
+    uint8_t target;                 // Curve value for level, in ticks
+    uint8_t on_ticks;               // What the display uses now (slewed)
+    uint8_t slew_count;             // Passes since the last change
+} AmbientLight;
+
+static AmbientLight ambient_light;     // Private to the file that calls ambient_light_update()
+
+// On-time for a sensor level, between two curve points
+static inline uint8_t ambient_light_curve_at(uint16_t level) {
+    uint8_t point = level >> 5;
+    uint8_t low = pgm_read_byte(&ambient_light_curve[point]);
+    uint8_t high = pgm_read_byte(&ambient_light_curve[point + 1]);
+    return low + (((high - low) * (level & 0x1F)) >> 5);
+}
+
+/**
+ * Set up the ADC (AVCC reference, ADC clock F_CPU/128), read the sensor once
+ * and set the brightness from it. PA0 becomes an input without pull-up.
+ * @param disp Display with timed OE on (vma419_set_oe_timing)
+ */
+static inline void ambient_light_init(VMA419_Display* disp) {
+    DDRA &= ~(1 << AMBIENT_LIGHT_CHANNEL);
+    PORTA &= ~(1 << AMBIENT_LIGHT_CHANNEL);
+
+    ADMUX = (1 << REFS0) | AMBIENT_LIGHT_CHANNEL;
+    ADCSRA = (1 << ADEN) | (1 << ADSC) | (1 << ADPS2) | (1 << ADPS1) | (1 << ADPS0);
+    while (ADCSRA & (1 << ADSC)) {
+        _delay_us(20);                  // First conversion: 25 ADC clocks = 400 us
+    }
+
+    AmbientLight* a = &ambient_light;
+    uint16_t sample = ADCW;
+    a->sum = sample << AMBIENT_LIGHT_FILTER_SHIFT;
+    a->level = sample;
+    a->target = a->on_ticks = ambient_light_curve_at(sample);
+    a->slew_count = 0;
+    vma419_set_oe_on_ticks(disp, a->on_ticks);
+
+    ADCSRA |= (1 << ADSC);              // The sample for the first update
+}
+
+/**
+ * Take the last sample (if the conversion is done) and move the brightness
+ * @param disp Display with timed OE on (vma419_set_oe_timing)
+ */
+static inline void ambient_light_update(VMA419_Display* disp) {
+    if (ADCSRA & (1 << ADSC)) return;   // Still converting
+    uint16_t sample = ADCW;
+    ADCSRA |= (1 << ADSC);              // Next one, ready by the next pass
+
+    AmbientLight* a = &ambient_light;
+    a->sum += sample - (a->sum >> AMBIENT_LIGHT_FILTER_SHIFT);
+    uint16_t average = a->sum >> AMBIENT_LIGHT_FILTER_SHIFT;
+
+    if (average > a->level + AMBIENT_LIGHT_HYSTERESIS) {
+        a->level = average - AMBIENT_LIGHT_HYSTERESIS;
+        a->target = ambient_light_curve_at(a->level);
+    } else if (average + AMBIENT_LIGHT_HYSTERESIS < a->level) {
+        a->level = average + AMBIENT_LIGHT_HYSTERESIS;
+        a->target = ambient_light_curve_at(a->level);
+    }
+
+    if (a->on_ticks == a->target) {
+        a->slew_count = 0;
+    } else if (++a->slew_count >= AMBIENT_LIGHT_SLEW_PASSES) {
+        a->slew_count = 0;
+        a->on_ticks += (a->target > a->on_ticks) ? 1 : -1;
+        vma419_set_oe_on_ticks(disp, a->on_ticks);
+    }
+}
+
+#else // AMBIENT_LIGHT_ENABLE == 0
+
+static inline void ambient_light_init(VMA419_Display* disp) { (void)disp; }
+static inline void ambient_light_update(VMA419_Display* disp) { (void)disp; }
+
+#endif // AMBIENT_LIGHT_ENABLE
+
+#endif // AMBIENT_LIGHT_H
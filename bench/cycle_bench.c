@@ -0,0 +1,248 @@
+/*
+ * ===================================================================
+ * Cycle Benchmarks for the Display Hot Paths
+ * ===================================================================
+ *
+ * What this program does:
+ * - Runs each drawing/scanning function the main loop depends on
+ * - Counts the CPU cycles every call takes with Timer1 (1 tick = 1 cycle)
+ * - Prints one "BENCH <name> <cycles>" line per function over UART,
+ *   then "BENCH done"
+ *
+ * It is meant to run in simavr (no board needed), where the numbers are
+ * exactly repeatable:
+ *   simavr -m atmega16 -f 8000000 bench/cycle_bench.elf
+ * tools/cycle_bench.py builds the command line, runs it and compares the
+ * results with tools/cycle_bench_baseline.json. On a real board, the same
+ * lines can be captured from the serial terminal and fed to the script.
+ *
+ * Why it matters: main.c spends 1 ms per scan phase, so everything that
+ * happens between two phases (clear, draw, scroll) must fit around it.
+ *
+ */
+
+#define F_CPU 8000000UL
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+#include <util/delay.h>
+#include <string.h>
+#include "vma419.h"
+#include "VMA419_Font.h"
+#include "fesb_logo.h"
+#include "font5x7_rows.h"       // VMA419_Font.h as a row font (tools/font_compile.py)
+#include "VMA419_FontCreator.h"
+#include "Cpp_Lib/DMD419/Arial14.h"
+
+#define BAUD 9600
+#define MYUBRR ((F_CPU / (16UL * BAUD)) - 1)
+
+VMA419_Display dmd_display;
+
+// Same wiring as main.c
+VMA419_PinConfig dmd_pins = {
+    .a_port_ddr        = &DDRA, .a_port_out        = &PORTA, .a_pin_mask        = (1 << PA1),
+    .b_port_ddr        = &DDRA, .b_port_out        = &PORTA, .b_pin_mask        = (1 << PA2),
+    .latch_clk_port_ddr= &DDRA, .latch_clk_port_out= &PORTA, .latch_clk_pin_mask= (1 << PA4),
+    .oe_port_ddr       = &DDRD, .oe_port_out       = &PORTD, .oe_pin_mask       = (1 << PD7)
+};
+
+// ===============================================
+// UART OUTPUT
+// ===============================================
+
+void USART_Init(unsigned int ubrr) {
+    UBRRH = (unsigned char)(ubrr >> 8);
+    UBRRL = (unsigned char)ubrr;
+    UCSRB = (1 << TXEN);                                 // Transmit only
+    UCSRC = (1 << URSEL) | (1 << UCSZ1) | (1 << UCSZ0);  // 8N1
+}
+
+void USART_Transmit(char data) {
+    while (!(UCSRA & (1 << UDRE)));
+    UDR = data;
+}
+
+void USART_SendString(const char* str) {
+    while (*str) {
+        USART_Transmit(*str++);
+    }
+}
+
+// Send a number as decimal text (0 to 4294967295), without leading zeros
+void USART_SendNumber32(uint32_t value) {
+    char digits[10];
+    uint8_t count = 0;
+
+    do {
+        digits[count++] = '0' + (value % 10);
+        value /= 10;
+    } while (value > 0);
+
+    while (count > 0) {
+        USART_Transmit(digits[--count]);
+    }
+}
+
+// ===============================================
+// CYCLE COUNTER (Timer1, no prescaler)
+// ===============================================
+// Timer1 counts every CPU cycle. It overflows after 65536 cycles, so the
+// overflow interrupt extends it to 32 bits for the slow functions.
+
+volatile uint16_t timer1_overflows = 0;
+uint32_t bench_overhead = 0;   // Cycles of an empty measurement, subtracted from every result
+
+ISR(TIMER1_OVF_vect) {
+    timer1_overflows++;
+}
+
+static inline void bench_start(void) {
+    TCCR1B = 0;                 // Stop the timer
+    TCNT1 = 0;
+    timer1_overflows = 0;
+    TIFR = (1 << TOV1);         // Clear a pending overflow
+    TCCR1B = (1 << CS10);       // Start counting at the CPU clock
+}
+
+static inline uint32_t bench_stop(void) {
+    TCCR1B = 0;                 // Stop first, then read
+    cli();
+    uint16_t low = TCNT1;
+    if (TIFR & (1 << TOV1)) {   // Overflow the interrupt has not handled yet
+        timer1_overflows++;
+        TIFR = (1 << TOV1);
+    }
+    uint32_t cycles = ((uint32_t)timer1_overflows << 16) | low;
+    sei();
+    return cycles;
+}
+
+// Print one result line, per call when the function ran 'calls' times
+static void bench_report(const char* name, uint32_t cycles, uint16_t calls) {
+    cycles = (cycles > bench_overhead) ? cycles - bench_overhead : 0;
+    USART_SendString("BENCH ");
+    USART_SendString(name);
+    USART_Transmit(' ');
+    USART_SendNumber32(cycles / calls);
+    USART_SendString("\r\n");
+}
+
+// ===============================================
+// THE BENCHMARKS
+// ===============================================
+// Names are kept stable, the baseline JSON is keyed by them.
+
+static const char bench_text[] = "WELCOME ERASMUS STUDENTS ";
+
+int main(void) {
+    USART_Init(MYUBRR);
+
+    TCCR1A = 0;                 // Timer1 normal mode
+    TIMSK |= (1 << TOIE1);      // Overflow interrupt for 32-bit counts
+    sei();
+
+    if (vma419_init(&dmd_display, &dmd_pins, 1, 1) != 0) {
+        USART_SendString("BENCH error init\r\n");
+        while (1);
+    }
+    vma419_font_init(&dmd_display);
+
+    // Calibrate: cost of bench_start() + bench_stop() alone
+    bench_start();
+    bench_overhead = bench_stop();
+
+    uint32_t cycles;
+
+    // Clear the whole frame buffer
+    bench_start();
+    vma419_clear(&dmd_display);
+    bench_report("clear", bench_stop(), 1);
+
+    // One pixel, averaged over the whole screen
+    bench_start();
+    for (uint8_t y = 0; y < 16; y++) {
+        for (uint8_t x = 0; x < 32; x++) {
+            vma419_set_pixel(&dmd_display, x, y, (x ^ y) & 1);
+        }
+    }
+    bench_report("set_pixel", bench_stop(), 512);
+
+    // Text as the main loop draws it: from the left edge, and partly scrolled out
+    vma419_clear(&dmd_display);
+    bench_start();
+    vma419_font_draw_string(&dmd_display, 0, 4, bench_text);
+    bench_report("draw_string", bench_stop(), 1);
+
+    vma419_clear(&dmd_display);
+    bench_start();
+    vma419_font_draw_string(&dmd_display, -37, 4, bench_text);
+    bench_report("draw_string_clipped", bench_stop(), 1);
+
+    // The same text from a row font: glyph rows are written as bytes
+    vma419_clear(&dmd_display);
+    bench_start();
+    vma419_draw_text_P(&dmd_display, 0, 4, bench_font5x7_rows, bench_text);
+    bench_report("draw_text_rowfont", bench_stop(), 1);
+
+    // The main loop's proportional font (glyph lookup through the width index)
+    VMA419_FCFont arial;
+    vma419_fc_select(&arial, Arial_14);
+    vma419_clear(&dmd_display);
+    bench_start();
+    vma419_fc_draw_string(&dmd_display, &arial, 0, 1, bench_text);
+    bench_report("draw_string_arial14", bench_stop(), 1);
+
+    // The startup logo
+    bench_start();
+    fesb_logo_display(&dmd_display);
+    bench_report("logo", bench_stop(), 1);
+
+    // One scan phase and a full 4-phase frame (includes the 10 us latch pulse)
+    dmd_display.scan_cycle = 0;
+    bench_start();
+    vma419_scan_display_quarter(&dmd_display);
+    bench_report("scan_phase", bench_stop(), 1);
+
+    bench_start();
+    for (uint8_t cycle = 0; cycle < 4; cycle++) {
+        dmd_display.scan_cycle = cycle;
+        vma419_scan_display_quarter(&dmd_display);
+    }
+    bench_report("scan_frame", bench_stop(), 1);
+
+    // One scroll step of the main loop without the 1 ms waits:
+    // clear, draw the text at the new position, scan all 4 phases.
+    // Averaged over a full pass of the text across the screen.
+    int16_t position = 32;
+    int16_t text_width = strlen(bench_text) * 6;
+    uint16_t steps = 0;
+    cycles = 0;
+    while (position >= -text_width) {
+        bench_start();
+        vma419_clear(&dmd_display);
+        vma419_font_draw_string(&dmd_display, position, 4, bench_text);
+        for (uint8_t cycle = 0; cycle < 4; cycle++) {
+            dmd_display.scan_cycle = cycle;
+            vma419_scan_display_quarter(&dmd_display);
+        }
+        cycles += bench_stop() - bench_overhead;
+        position--;
+        steps++;
+    }
+    bench_overhead = 0;         // Already subtracted per step
+    bench_report("scroll_step", cycles, steps);
+
+    USART_SendString("BENCH done\r\n");
+
+    // Make sure the last line is out, then stop (simavr ends on sleep with interrupts off)
+    _delay_ms(20);
+    cli();
+    sleep_enable();
+    while (1) {
+        sleep_cpu();
+    }
+
+    return 0;
+}
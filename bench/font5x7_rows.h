@@ -0,0 +1,437 @@
+/*
+ * font5x7_rows.h - bench_font5x7_rows, row font for vma419_draw_text_P()
+ *
+ * Generated by tools/font_compile.py from VMA419_Font.h, do not edit.
+ * 7 pixels high, 43 glyphs, 572 bytes of flash.
+ *
+ */
+
+#ifndef FONT5X7_ROWS_H
+#define FONT5X7_ROWS_H
+
+#include <stdint.h>
+#include <avr/pgmspace.h>
+
+#define BENCH_FONT5X7_ROWS_HEIGHT     7
+#define BENCH_FONT5X7_ROWS_FIRST_CHAR 32
+#define BENCH_FONT5X7_ROWS_CHAR_COUNT 89
+
+const uint8_t bench_font5x7_rows[] PROGMEM = {
+    7, 32, 89, 1,  // height, first char, char count, spacing
+
+    // widths
+    5, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 5, 0, 0, 5, 0, 0, 5, 0, 0, 0,
+    0, 5, 0, 0, 0, 0, 0, 0, 0, 5, 5, 5,
+    5, 5, 5, 0, 5, 0, 0, 0, 5, 5, 5, 5,
+    0, 0, 5, 5, 5, 5, 5, 5, 0, 0, 0, 0,
+    0, 0, 0, 5, 0, 5, 5, 5, 5, 5, 5, 5,
+    5, 5, 0, 0, 5, 5, 5, 5, 5, 0, 5, 5,
+    5, 0, 5, 5, 5,
+
+    // offsets (low, high)
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0e, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x15, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x1c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x23, 0x00, 0x2a, 0x00, 0x31, 0x00,
+    0x38, 0x00, 0x3f, 0x00, 0x46, 0x00, 0x00, 0x00, 0x4d, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x54, 0x00, 0x5b, 0x00, 0x62, 0x00, 0x69, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x70, 0x00, 0x77, 0x00, 0x7e, 0x00, 0x85, 0x00,
+    0x8c, 0x00, 0x93, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x9a, 0x00, 0x00, 0x00, 0xa1, 0x00,
+    0xa8, 0x00, 0xaf, 0x00, 0xb6, 0x00, 0xbd, 0x00, 0xc4, 0x00, 0xcb, 0x00,
+    0xd2, 0x00, 0xd9, 0x00, 0x00, 0x00, 0x00, 0x00, 0xe0, 0x00, 0xe7, 0x00,
+    0xee, 0x00, 0xf5, 0x00, 0xfc, 0x00, 0x00, 0x00, 0x03, 0x01, 0x0a, 0x01,
+    0x11, 0x01, 0x00, 0x00, 0x18, 0x01, 0x1f, 0x01, 0x26, 0x01,
+
+    // 0x20, 5 px
+    0x00,                    // .....
+    0x00,                    // .....
+    0x00,                    // .....
+    0x00,                    // .....
+    0x00,                    // .....
+    0x00,                    // .....
+    0x00,                    // .....
+
+    // '.', 5 px
+    0x00,                    // .....
+    0x00,                    // .....
+    0x00,                    // .....
+    0x00,                    // .....
+    0x00,                    // .....
+    0x60,                    // .##..
+    0x60,                    // .##..
+
+    // '1', 5 px
+    0x20,                    // ..#..
+    0x60,                    // .##..
+    0x20,                    // ..#..
+    0x20,                    // ..#..
+    0x20,                    // ..#..
+    0x20,                    // ..#..
+    0x70,                    // .###.
+
+    // '4', 5 px
+    0x10,                    // ...#.
+    0x30,                    // ..##.
+    0x50,                    // .#.#.
+    0x90,                    // #..#.
+    0xf8,                    // #####
+    0x10,                    // ...#.
+    0x10,                    // ...#.
+
+    // '9', 5 px
+    0x70,                    // .###.
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0x78,                    // .####
+    0x08,                    // ....#
+    0x10,                    // ...#.
+    0x60,                    // .##..
+
+    // 'A', 5 px
+    0x70,                    // .###.
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0xf8,                    // #####
+    0x88,                    // #...#
+    0x88,                    // #...#
+
+    // 'B', 5 px
+    0xf0,                    // ####.
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0xf0,                    // ####.
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0xf0,                    // ####.
+
+    // 'C', 5 px
+    0x70,                    // .###.
+    0x88,                    // #...#
+    0x80,                    // #....
+    0x80,                    // #....
+    0x80,                    // #....
+    0x88,                    // #...#
+    0x70,                    // .###.
+
+    // 'D', 5 px
+    0xe0,                    // ###..
+    0x90,                    // #..#.
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0x90,                    // #..#.
+    0xe0,                    // ###..
+
+    // 'E', 5 px
+    0xf8,                    // #####
+    0x80,                    // #....
+    0x80,                    // #....
+    0xf0,                    // ####.
+    0x80,                    // #....
+    0x80,                    // #....
+    0xf8,                    // #####
+
+    // 'F', 5 px
+    0xf8,                    // #####
+    0x80,                    // #....
+    0x80,                    // #....
+    0xe0,                    // ###..
+    0x80,                    // #....
+    0x80,                    // #....
+    0x80,                    // #....
+
+    // 'H', 5 px
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0xf8,                    // #####
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0x88,                    // #...#
+
+    // 'L', 5 px
+    0x80,                    // #....
+    0x80,                    // #....
+    0x80,                    // #....
+    0x80,                    // #....
+    0x80,                    // #....
+    0x80,                    // #....
+    0xf8,                    // #####
+
+    // 'M', 5 px
+    0x88,                    // #...#
+    0xd8,                    // ##.##
+    0xa8,                    // #.#.#
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0x88,                    // #...#
+
+    // 'N', 5 px
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0xc8,                    // ##..#
+    0xa8,                    // #.#.#
+    0x98,                    // #..##
+    0x88,                    // #...#
+    0x88,                    // #...#
+
+    // 'O', 5 px
+    0x70,                    // .###.
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0x70,                    // .###.
+
+    // 'R', 5 px
+    0xf0,                    // ####.
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0xf0,                    // ####.
+    0xa0,                    // #.#..
+    0x90,                    // #..#.
+    0x88,                    // #...#
+
+    // 'S', 5 px
+    0x78,                    // .####
+    0x80,                    // #....
+    0x80,                    // #....
+    0x70,                    // .###.
+    0x08,                    // ....#
+    0x08,                    // ....#
+    0xf0,                    // ####.
+
+    // 'T', 5 px
+    0xf8,                    // #####
+    0x20,                    // ..#..
+    0x20,                    // ..#..
+    0x20,                    // ..#..
+    0x20,                    // ..#..
+    0x20,                    // ..#..
+    0x20,                    // ..#..
+
+    // 'U', 5 px
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0x70,                    // .###.
+
+    // 'V', 5 px
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0x50,                    // .#.#.
+    0x20,                    // ..#..
+
+    // 'W', 5 px
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0xa8,                    // #.#.#
+    0xa8,                    // #.#.#
+    0xd8,                    // ##.##
+    0x88,                    // #...#
+
+    // '_', 5 px
+    0x00,                    // .....
+    0x00,                    // .....
+    0x00,                    // .....
+    0x00,                    // .....
+    0x00,                    // .....
+    0x00,                    // .....
+    0xf8,                    // #####
+
+    // 'a', 5 px
+    0x00,                    // .....
+    0x00,                    // .....
+    0x70,                    // .###.
+    0x08,                    // ....#
+    0x78,                    // .####
+    0x88,                    // #...#
+    0x78,                    // .####
+
+    // 'b', 5 px
+    0x80,                    // #....
+    0x80,                    // #....
+    0xb0,                    // #.##.
+    0xc8,                    // ##..#
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0xf0,                    // ####.
+
+    // 'c', 5 px
+    0x00,                    // .....
+    0x00,                    // .....
+    0x70,                    // .###.
+    0x80,                    // #....
+    0x80,                    // #....
+    0x88,                    // #...#
+    0x70,                    // .###.
+
+    // 'd', 5 px
+    0x08,                    // ....#
+    0x08,                    // ....#
+    0x68,                    // .##.#
+    0x98,                    // #..##
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0x78,                    // .####
+
+    // 'e', 5 px
+    0x00,                    // .....
+    0x00,                    // .....
+    0x70,                    // .###.
+    0x88,                    // #...#
+    0xf8,                    // #####
+    0x80,                    // #....
+    0x70,                    // .###.
+
+    // 'f', 5 px
+    0x30,                    // ..##.
+    0x48,                    // .#..#
+    0x40,                    // .#...
+    0xe0,                    // ###..
+    0x40,                    // .#...
+    0x40,                    // .#...
+    0x40,                    // .#...
+
+    // 'g', 5 px
+    0x00,                    // .....
+    0x00,                    // .....
+    0x78,                    // .####
+    0x88,                    // #...#
+    0x78,                    // .####
+    0x08,                    // ....#
+    0x30,                    // ..##.
+
+    // 'h', 5 px
+    0x80,                    // #....
+    0x80,                    // #....
+    0xb0,                    // #.##.
+    0xc8,                    // ##..#
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0x88,                    // #...#
+
+    // 'i', 5 px
+    0x20,                    // ..#..
+    0x00,                    // .....
+    0x60,                    // .##..
+    0x20,                    // ..#..
+    0x20,                    // ..#..
+    0x20,                    // ..#..
+    0x70,                    // .###.
+
+    // 'l', 5 px
+    0x60,                    // .##..
+    0x20,                    // ..#..
+    0x20,                    // ..#..
+    0x20,                    // ..#..
+    0x20,                    // ..#..
+    0x20,                    // ..#..
+    0x70,                    // .###.
+
+    // 'm', 5 px
+    0x00,                    // .....
+    0x00,                    // .....
+    0xd0,                    // ##.#.
+    0xa8,                    // #.#.#
+    0xa8,                    // #.#.#
+    0x88,                    // #...#
+    0x88,                    // #...#
+
+    // 'n', 5 px
+    0x00,                    // .....
+    0x00,                    // .....
+    0xb0,                    // #.##.
+    0xc8,                    // ##..#
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0x88,                    // #...#
+
+    // 'o', 5 px
+    0x00,                    // .....
+    0x00,                    // .....
+    0x70,                    // .###.
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0x70,                    // .###.
+
+    // 'p', 5 px
+    0x00,                    // .....
+    0x00,                    // .....
+    0xf0,                    // ####.
+    0x88,                    // #...#
+    0xf0,                    // ####.
+    0x80,                    // #....
+    0x80,                    // #....
+
+    // 'r', 5 px
+    0x00,                    // .....
+    0x00,                    // .....
+    0xb0,                    // #.##.
+    0xc8,                    // ##..#
+    0x80,                    // #....
+    0x80,                    // #....
+    0x80,                    // #....
+
+    // 's', 5 px
+    0x00,                    // .....
+    0x00,                    // .....
+    0x70,                    // .###.
+    0x80,                    // #....
+    0x70,                    // .###.
+    0x08,                    // ....#
+    0xf0,                    // ####.
+
+    // 't', 5 px
+    0x40,                    // .#...
+    0x40,                    // .#...
+    0xe0,                    // ###..
+    0x40,                    // .#...
+    0x40,                    // .#...
+    0x48,                    // .#..#
+    0x30,                    // ..##.
+
+    // 'v', 5 px
+    0x00,                    // .....
+    0x00,                    // .....
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0x50,                    // .#.#.
+    0x20,                    // ..#..
+
+    // 'w', 5 px
+    0x00,                    // .....
+    0x00,                    // .....
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0xa8,                    // #.#.#
+    0xa8,                    // #.#.#
+    0x50,                    // .#.#.
+
+    // 'x', 5 px
+    0x00,                    // .....
+    0x00,                    // .....
+    0x88,                    // #...#
+    0x50,                    // .#.#.
+    0x20,                    // ..#..
+    0x50,                    // .#.#.
+    0x88,                    // #...#
+};
+
+#endif // FONT5X7_ROWS_H
@@ -7,7 +7,11 @@
  * 
  * The logo has been stylized to fit the 32x16 resolution while
  * maintaining the recognizable FESB letter forms.
- * 
+ *
+ * The pixels live in flash (fesb_logo_bitmap.h). To change the logo, edit
+ * image/fesb_logo.pbm and regenerate the header:
+ *   python3 tools/bitmap_compile.py image/fesb_logo.pbm -o fesb_logo_bitmap.h
+ *
  */
 
 #ifndef FESB_LOGO_H
@@ -15,28 +19,18 @@
 
 #include <stdint.h>
 #include "vma419.h"
+#include "fesb_logo_bitmap.h"   // Logo in flash, made from image/fesb_logo.pbm
 
 // FESB Logo dimensions
-#define FESB_LOGO_WIDTH  32
-#define FESB_LOGO_HEIGHT 16
-
-// FESB Logo bitmap data (32x16 pixels = 64 bytes)
-// Recreated based on the actual FESB university logo
-// The real logo features bold, modern block letters with specific styling
-// Each byte represents 8 horizontal pixels, MSB = leftmost pixel
-// Bit 1 = LED ON, Bit 0 = LED OFF
-const uint8_t fesb_logo_bitmap[FESB_LOGO_HEIGHT][FESB_LOGO_WIDTH/8] = {
-~0xff, ~0xff, ~0xff, ~0xff, ~0xff, ~0xff, ~0xff, ~0xff, ~0xe0, ~0x40, ~0x80, ~0x07, ~0xc0, ~0x80, ~0x00, ~0x03, 
-~0x87, ~0x8f, ~0x0d, ~0xe3, ~0x8f, ~0x9f, ~0x1f, ~0xf1, ~0x9f, ~0xbf, ~0x1f, ~0xe3, ~0xa0, ~0x40, ~0x02, ~0x03, 
-~0xc0, ~0x80, ~0x81, ~0x03, ~0x87, ~0x8f, ~0xf1, ~0xe3, ~0x8f, ~0x9f, ~0xf9, ~0xf1, ~0x8f, ~0x8d, ~0xe1, ~0xe3, 
-~0x8f, ~0x80, ~0x01, ~0x03, ~0x8f, ~0xc0, ~0x02, ~0x07, ~0xff, ~0xff, ~0xff, ~0xff, ~0xff, ~0xff, ~0xff, ~0xff
-};
+#define FESB_LOGO_WIDTH  FESB_LOGO_BITMAP_WIDTH
+#define FESB_LOGO_HEIGHT FESB_LOGO_BITMAP_HEIGHT
 
 /**
  * Display the FESB logo on the VMA419 LED matrix
  * 
  * This function draws the complete FESB logo bitmap to the display buffer.
- * The logo is designed to fill the entire 32x16 display area.
+ * The logo is designed to fill one 32x16 panel; on a wall of several
+ * panels it is drawn in the middle.
  * 
  * @param disp Pointer to VMA419 display structure
  */
@@ -65,24 +59,10 @@ void fesb_logo_display(VMA419_Display* disp) {
     // Clear the display buffer first
     vma419_clear(disp);
     
-    // Draw the FESB logo pixel by pixel
-    for (uint8_t row = 0; row < FESB_LOGO_HEIGHT; row++) {
-        for (uint8_t byte_col = 0; byte_col < (FESB_LOGO_WIDTH/8); byte_col++) {            // Read bitmap byte from regular memory
-            uint8_t bitmap_byte = fesb_logo_bitmap[row][byte_col];
-            
-            // Process each bit in the byte (8 pixels)
-            for (uint8_t bit = 0; bit < 8; bit++) {
-                uint8_t x = byte_col * 8 + bit;
-                uint8_t y = row;
-                
-                // Extract pixel value (MSB first)
-                uint8_t pixel = (bitmap_byte >> (7 - bit)) & 0x01;
-                
-                // Set pixel in display buffer
-                vma419_set_pixel(disp, x, y, pixel);
-            }
-        }
-    }
+    // Unpack the logo from flash straight into the display buffer
+    // (centered, which is the top left corner on a single panel)
+    vma419_draw_bitmap_P(disp, ((int16_t)disp->total_width_pixels - FESB_LOGO_WIDTH) / 2,
+                         ((int16_t)disp->total_height_pixels - FESB_LOGO_HEIGHT) / 2, fesb_logo_bitmap);
 }
 
 void fesb_logo_show_for_duration(VMA419_Display* disp, uint8_t duration_seconds) {
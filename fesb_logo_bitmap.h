@@ -0,0 +1,44 @@
+/*
+ * fesb_logo_bitmap.h - fesb_logo_bitmap, 32x16 pixels
+ *
+ * Generated by tools/bitmap_compile.py from fesb_logo.pbm, do not edit.
+ * Format RLE, 57 bytes of flash (4 of them header). Draw it with
+ *   vma419_draw_bitmap_P(&display, x, y, fesb_logo_bitmap);
+ *
+ *   ................................
+ *   ................................
+ *   ...######.######.############...
+ *   ..######.#####################..
+ *   .####....###....####..#....###..
+ *   .###.....##.....###.........###.
+ *   .##......#......###........###..
+ *   .#.######.############.#######..
+ *   ..######.#######.######.######..
+ *   .####....###........###....###..
+ *   .###.....##..........##.....###.
+ *   .###.....###..#....####....###..
+ *   .###.....##############.######..
+ *   .###......############.######...
+ *   ................................
+ *   ................................
+ */
+
+#ifndef FESB_LOGO_BITMAP_H
+#define FESB_LOGO_BITMAP_H
+
+#include <stdint.h>
+#include <avr/pgmspace.h>
+
+#define FESB_LOGO_BITMAP_WIDTH  32
+#define FESB_LOGO_BITMAP_HEIGHT 16
+
+const uint8_t fesb_logo_bitmap[] PROGMEM = {
+    2, 32, 0, 16,  // RLE, width 32, height 16
+    0x85, 0x00, 0x2f, 0x1f, 0xbf, 0x7f, 0xf8, 0x3f, 0x7f, 0xff, 0xfc, 0x78,
+    0x70, 0xf2, 0x1c, 0x70, 0x60, 0xe0, 0x0e, 0x60, 0x40, 0xe0, 0x1c, 0x5f,
+    0xbf, 0xfd, 0xfc, 0x3f, 0x7f, 0x7e, 0xfc, 0x78, 0x70, 0x0e, 0x1c, 0x70,
+    0x60, 0x06, 0x0e, 0x70, 0x72, 0x1e, 0x1c, 0x70, 0x7f, 0xfe, 0xfc, 0x70,
+    0x3f, 0xfd, 0xf8, 0x85, 0x00,
+};
+
+#endif // FESB_LOGO_BITMAP_H
@@ -0,0 +1,185 @@
+/*
+ * ambient_sim.c - Run the Ambient Light Control Loop on Made-Up Light (host build)
+ *
+ * ambient_light.h is compiled unchanged on top of the host HAL. The light
+ * sensor (ADC0) follows a light profile, the firmware loop runs once per
+ * main loop pass (4 ms of virtual time) and the LED on-time it picks is
+ * printed as CSV, so the filter, hysteresis and slew settings can be tuned
+ * on the PC and compared in a spreadsheet or plot.
+ *
+ * The default profile is a night, a sunrise, a passing cloud and a sudden
+ * dusk. A profile file has one "<seconds> <sensor 0-1023>" point per line;
+ * the light moves in a straight line between points ('#' starts a comment).
+ *
+ * Output, one line per --every milliseconds:
+ *   time_s,light,average,level,on_ticks,on_us
+ * and a summary on stderr: the on-time range and how often it turned
+ * around (the number hysteresis should keep low on a noisy sensor).
+ *
+ * Usage:
+ *   ./ambient_sim [--profile FILE] [--noise N] [--every MS] [--seed N]
+ *   make -B ambient_sim AMBIENT_DEFS="-DAMBIENT_LIGHT_HYSTERESIS=8"   (other settings)
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include "host_hal.h"
+#include "vma419.h"
+#include "ambient_light.h"
+
+#define PASS_US      4000               // One main loop pass: 4 scan phases of 1 ms
+#define MAX_POINTS   256
+
+typedef struct {
+    double seconds;
+    double light;
+} ProfilePoint;
+
+static const ProfilePoint default_profile[] = {
+    {  0.0,   60 }, {  5.0,   60 },     // night
+    { 25.0,  900 }, { 35.0,  900 },     // sunrise, full sun
+    { 35.5,  600 }, { 38.5,  600 },     // a cloud passes
+    { 39.0,  900 }, { 50.0,  900 },
+    { 52.0,   60 }, { 60.0,   60 },     // sudden dusk
+};
+
+static ProfilePoint profile[MAX_POINTS];
+static unsigned profile_count;
+static unsigned noise = 8;              // +- sensor counts of random noise
+static uint32_t rng_state = 1;
+
+static VMA419_PinConfig host_pins = {
+    .a_port_ddr         = &DDRA, .a_port_out         = &PORTA, .a_pin_mask         = (1 << PA1),
+    .b_port_ddr         = &DDRA, .b_port_out         = &PORTA, .b_pin_mask         = (1 << PA2),
+    .latch_clk_port_ddr = &DDRA, .latch_clk_port_out = &PORTA, .latch_clk_pin_mask = (1 << PA4),
+    .oe_port_ddr        = &DDRD, .oe_port_out        = &PORTD, .oe_pin_mask        = (1 << PD7)
+};
+
+// Timer2 compare match ends the OE pulse, as in main.c
+VMA419_OE_TIMER2_ISR()
+
+static uint32_t rng_next(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+static void profile_load(const char* path) {
+    FILE* f = fopen(path, "r");
+    if (!f) {
+        perror(path);
+        exit(2);
+    }
+    char line[128];
+    while (fgets(line, sizeof(line), f) && profile_count < MAX_POINTS) {
+        ProfilePoint p;
+        if (line[0] == '#' || sscanf(line, "%lf %lf", &p.seconds, &p.light) != 2) continue;
+        if (profile_count > 0 && p.seconds < profile[profile_count - 1].seconds) {
+            fprintf(stderr, "%s: times must not go backwards\n", path);
+            exit(2);
+        }
+        profile[profile_count++] = p;
+    }
+    fclose(f);
+    if (profile_count == 0) {
+        fprintf(stderr, "%s: no points found\n", path);
+        exit(2);
+    }
+}
+
+// The light without noise at a time
+static double profile_at(double seconds) {
+    if (seconds <= profile[0].seconds) return profile[0].light;
+    for (unsigned i = 1; i < profile_count; i++) {
+        const ProfilePoint* a = &profile[i - 1];
+        const ProfilePoint* b = &profile[i];
+        if (seconds <= b->seconds) {
+            if (b->seconds == a->seconds) return b->light;
+            return a->light + (b->light - a->light) * (seconds - a->seconds) / (b->seconds - a->seconds);
+        }
+    }
+    return profile[profile_count - 1].light;
+}
+
+static uint16_t light_sensor(uint8_t channel) {
+    double value = profile_at(host_time_us / 1e6);
+    if (noise) value += (int)(rng_next() % (2 * noise + 1)) - (int)noise;
+    if (value < 0) value = 0;
+    if (value > 1023) value = 1023;
+    return (uint16_t)(value + 0.5);
+}
+
+int main(int argc, char** argv) {
+    unsigned every_ms = 100;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--profile") == 0 && i + 1 < argc) {
+            profile_load(argv[++i]);
+        } else if (strcmp(argv[i], "--noise") == 0 && i + 1 < argc) {
+            noise = (unsigned)atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--every") == 0 && i + 1 < argc) {
+            every_ms = (unsigned)atoi(argv[++i]);
+            if (every_ms == 0) every_ms = 1;
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            rng_state = (uint32_t)strtoul(argv[++i], NULL, 0);
+            if (rng_state == 0) rng_state = 1;
+        } else {
+            fprintf(stderr, "Usage: %s [--profile FILE] [--noise N] [--every MS] [--seed N]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (profile_count == 0) {
+        profile_count = sizeof(default_profile) / sizeof(default_profile[0]);
+        memcpy(profile, default_profile, sizeof(default_profile));
+    }
+
+    VMA419_Display disp;
+    host_reset();
+    host_adc_set_input(light_sensor);
+    if (vma419_init(&disp, &host_pins, 1, 1) != 0) {
+        fprintf(stderr, "vma419_init failed\n");
+        return 2;
+    }
+    vma419_set_oe_timing(&disp, VMA419_OE_PHASE_TICKS, 0, 100);
+    ambient_light_init(&disp);
+
+    uint32_t end_us = (uint32_t)(profile[profile_count - 1].seconds * 1e6) + PASS_US;
+    uint32_t next_print_us = 0;
+    uint8_t min_ticks = 255, max_ticks = 0, last_ticks = 0;
+    int last_direction = 0;
+    unsigned changes = 0, reversals = 0;
+
+    printf("time_s,light,average,level,on_ticks,on_us\n");
+    while (host_time_us < end_us) {
+        ambient_light_update(&disp);
+        uint8_t ticks = disp.oe_on_ticks;
+
+        if (ticks < min_ticks) min_ticks = ticks;
+        if (ticks > max_ticks) max_ticks = ticks;
+        if (last_ticks && ticks != last_ticks) {
+            int direction = (ticks > last_ticks) ? 1 : -1;
+            if (last_direction && direction != last_direction) reversals++;
+            last_direction = direction;
+            changes++;
+        }
+        last_ticks = ticks;
+        if (host_time_us >= next_print_us) {
+            printf("%.3f,%.0f,%u,%u,%u,%u\n", host_time_us / 1e6, profile_at(host_time_us / 1e6),
+                   ambient_light.sum >> AMBIENT_LIGHT_FILTER_SHIFT, ambient_light.level,
+                   ticks, ticks * VMA419_OE_TICK_US);
+            next_print_us += every_ms * 1000UL;
+        }
+        host_delay_us(PASS_US);
+    }
+
+    fprintf(stderr, "on-time %u..%u us, %u changes, %u reversals in %.1f s\n",
+            min_ticks * VMA419_OE_TICK_US, max_ticks * VMA419_OE_TICK_US,
+            changes, reversals, host_time_us / 1e6);
+    vma419_deinit(&disp);
+    return 0;
+}
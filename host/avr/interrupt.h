@@ -0,0 +1,19 @@
+/*
+ * host/avr/interrupt.h - Interrupt macros for the host build
+ *
+ * ISR(vector) becomes a normal function with the vector's name, so the host
+ * HAL (or a tool) can call it when the "hardware event" happens.
+ * sei()/cli() only set/clear the I bit in the fake SREG.
+ */
+
+#ifndef HOST_AVR_INTERRUPT_H
+#define HOST_AVR_INTERRUPT_H
+
+#include <avr/io.h>
+
+#define ISR(vector, ...)   void vector(void); void vector(void)
+
+#define sei()              (SREG |= (1 << SREG_I))
+#define cli()              (SREG &= (uint8_t)~(1 << SREG_I))
+
+#endif // HOST_AVR_INTERRUPT_H
@@ -0,0 +1,255 @@
+/*
+ * host/avr/io.h - ATmega16 register names for the host build
+ *
+ * Stands in for avr-libc's <avr/io.h>. Every register is a byte of
+ * host_io[] at its real I/O address, so &PORTA, |=, &= ~ etc. all work like
+ * on the chip. SPDR, SPSR, UDR and TCNT1 go through host_hal.c, which plays
+ * the SPI, UART and Timer1 peripherals. Timer2 stays plain bytes; host_hal.c
+ * runs it (compare match only) while virtual time passes.
+ */
+
+#ifndef HOST_AVR_IO_H
+#define HOST_AVR_IO_H
+
+#include <stdint.h>
+#include "host_hal.h"
+
+#define _HOST_IO8(addr)   (host_io[(addr)])
+// 16-bit registers sit at odd addresses too (SP is at 0x3D)
+typedef uint16_t __attribute__((aligned(1))) _host_io16_t;
+#define _HOST_IO16(addr)  (*(volatile _host_io16_t*)&host_io[(addr)])
+
+//------------------------------------------------------------------------------
+// Registers (ATmega16 I/O addresses)
+//------------------------------------------------------------------------------
+#define TWBR    _HOST_IO8(0x00)
+#define TWSR    _HOST_IO8(0x01)
+#define TWAR    _HOST_IO8(0x02)
+#define TWDR    _HOST_IO8(0x03)
+#define ADC     _HOST_IO16(0x04)
+#define ADCW    ADC
+#define ADCL    _HOST_IO8(0x04)
+#define ADCH    _HOST_IO8(0x05)
+#define ADCSRA  _HOST_IO8(0x06)
+#define ADMUX   _HOST_IO8(0x07)
+#define ACSR    _HOST_IO8(0x08)
+#define UBRRL   _HOST_IO8(0x09)
+#define UCSRB   _HOST_IO8(0x0A)
+#define UCSRA   _HOST_IO8(0x0B)
+#define UDR     (*host_uart_data())
+#define SPCR    _HOST_IO8(0x0D)
+#define SPSR    (*host_spi_status())
+#define SPDR    (*host_spi_data())
+#define PIND    _HOST_IO8(0x10)
+#define DDRD    _HOST_IO8(0x11)
+#define PORTD   _HOST_IO8(0x12)
+#define PINC    _HOST_IO8(0x13)
+#define DDRC    _HOST_IO8(0x14)
+#define PORTC   _HOST_IO8(0x15)
+#define PINB    _HOST_IO8(0x16)
+#define DDRB    _HOST_IO8(0x17)
+#define PORTB   _HOST_IO8(0x18)
+#define PINA    _HOST_IO8(0x19)
+#define DDRA    _HOST_IO8(0x1A)
+#define PORTA   _HOST_IO8(0x1B)
+#define EECR    _HOST_IO8(0x1C)
+#define EEDR    _HOST_IO8(0x1D)
+#define EEAR    _HOST_IO16(0x1E)
+#define EEARL   _HOST_IO8(0x1E)
+#define EEARH   _HOST_IO8(0x1F)
+#define UBRRH   _HOST_IO8(0x20)
+#define UCSRC   _HOST_IO8(0x20)   // shares its address with UBRRH (URSEL selects)
+#define WDTCR   _HOST_IO8(0x21)
+#define ASSR    _HOST_IO8(0x22)
+#define OCR2    _HOST_IO8(0x23)
+#define TCNT2   _HOST_IO8(0x24)
+#define TCCR2   _HOST_IO8(0x25)
+#define ICR1    _HOST_IO16(0x26)
+#define OCR1B   _HOST_IO16(0x28)
+#define OCR1A   _HOST_IO16(0x2A)
+#define TCNT1   (*host_timer1_count())
+#define TCCR1B  _HOST_IO8(0x2E)
+#define TCCR1A  _HOST_IO8(0x2F)
+#define SFIOR   _HOST_IO8(0x30)
+#define OSCCAL  _HOST_IO8(0x31)
+#define TCNT0   _HOST_IO8(0x32)
+#define TCCR0   _HOST_IO8(0x33)
+#define MCUCSR  _HOST_IO8(0x34)
+#define MCUCR   _HOST_IO8(0x35)
+#define TWCR    _HOST_IO8(0x36)
+#define SPMCR   _HOST_IO8(0x37)
+#define TIFR    _HOST_IO8(0x38)
+#define TIMSK   _HOST_IO8(0x39)
+#define GIFR    _HOST_IO8(0x3A)
+#define GICR    _HOST_IO8(0x3B)
+#define OCR0    _HOST_IO8(0x3C)
+#define SP      _HOST_IO16(0x3D)
+#define SPL     _HOST_IO8(0x3D)
+#define SPH     _HOST_IO8(0x3E)
+#define SREG    _HOST_IO8(0x3F)
+
+#define RAMEND  0x45F
+
+//------------------------------------------------------------------------------
+// Port pins
+//------------------------------------------------------------------------------
+#define PA0 0
+#define PA1 1
+#define PA2 2
+#define PA3 3
+#define PA4 4
+#define PA5 5
+#define PA6 6
+#define PA7 7
+#define PB0 0
+#define PB1 1
+#define PB2 2
+#define PB3 3
+#define PB4 4
+#define PB5 5
+#define PB6 6
+#define PB7 7
+#define PC0 0
+#define PC1 1
+#define PC2 2
+#define PC3 3
+#define PC4 4
+#define PC5 5
+#define PC6 6
+#define PC7 7
+#define PD0 0
+#define PD1 1
+#define PD2 2
+#define PD3 3
+#define PD4 4
+#define PD5 5
+#define PD6 6
+#define PD7 7
+
+//------------------------------------------------------------------------------
+// Register bits
+//------------------------------------------------------------------------------
+// SPCR
+#define SPIE    7
+#define SPE     6
+#define DORD    5
+#define MSTR    4
+#define CPOL    3
+#define CPHA    2
+#define SPR1    1
+#define SPR0    0
+// SPSR
+#define SPIF    7
+#define WCOL    6
+#define SPI2X   0
+// UCSRA
+#define RXC     7
+#define TXC     6
+#define UDRE    5
+#define FE      4
+#define DOR     3
+#define PE      2
+#define U2X     1
+#define MPCM    0
+// UCSRB
+#define RXCIE   7
+#define TXCIE   6
+#define UDRIE   5
+#define RXEN    4
+#define TXEN    3
+#define UCSZ2   2
+#define RXB8    1
+#define TXB8    0
+// UCSRC
+#define URSEL   7
+#define UMSEL   6
+#define UPM1    5
+#define UPM0    4
+#define USBS    3
+#define UCSZ1   2
+#define UCSZ0   1
+#define UCPOL   0
+// ADMUX
+#define REFS1   7
+#define REFS0   6
+#define ADLAR   5
+#define MUX4    4
+#define MUX3    3
+#define MUX2    2
+#define MUX1    1
+#define MUX0    0
+// ADCSRA
+#define ADEN    7
+#define ADSC    6
+#define ADATE   5
+#define ADIF    4
+#define ADIE    3
+#define ADPS2   2
+#define ADPS1   1
+#define ADPS0   0
+// TCCR0
+#define FOC0    7
+#define WGM00   6
+#define COM01   5
+#define COM00   4
+#define WGM01   3
+#define CS02    2
+#define CS01    1
+#define CS00    0
+// TCCR2
+#define FOC2    7
+#define WGM20   6
+#define COM21   5
+#define COM20   4
+#define WGM21   3
+#define CS22    2
+#define CS21    1
+#define CS20    0
+// TIMSK / TIFR
+#define OCIE2   7
+#define TOIE2   6
+#define TICIE1  5
+#define OCIE1A  4
+#define OCIE1B  3
+#define TOIE1   2
+#define OCIE0   1
+#define TOIE0   0
+#define OCF2    7
+#define TOV2    6
+#define ICF1    5
+#define OCF1A   4
+#define OCF1B   3
+#define TOV1    2
+#define OCF0    1
+#define TOV0    0
+// TCCR1A
+#define COM1A1  7
+#define COM1A0  6
+#define COM1B1  5
+#define COM1B0  4
+#define FOC1A   3
+#define FOC1B   2
+#define WGM11   1
+#define WGM10   0
+// TCCR1B
+#define ICNC1   7
+#define ICES1   6
+#define WGM13   4
+#define WGM12   3
+#define CS12    2
+#define CS11    1
+#define CS10    0
+// MCUCR
+#define SM2     7
+#define SE      6
+#define SM1     5
+#define SM0     4
+// EECR
+#define EERIE   3
+#define EEMWE   2
+#define EEWE    1
+#define EERE    0
+// SREG
+#define SREG_I  7
+
+#endif // HOST_AVR_IO_H
@@ -0,0 +1,28 @@
+/*
+ * host/avr/pgmspace.h - PROGMEM for the host build
+ *
+ * A PC has one address space, so "flash" data is just const data and
+ * pgm_read_*() is a normal memory read.
+ */
+
+#ifndef HOST_AVR_PGMSPACE_H
+#define HOST_AVR_PGMSPACE_H
+
+#include <stdint.h>
+#include <string.h>
+
+#define PROGMEM
+#define PGM_P                    const char*
+#define PSTR(s)                  (s)
+
+#define pgm_read_byte(addr)      (*(const uint8_t*)(addr))
+#define pgm_read_word(addr)      (*(const uint16_t*)(addr))
+#define pgm_read_dword(addr)     (*(const uint32_t*)(addr))
+#define pgm_read_ptr(addr)       (*(void* const*)(addr))
+
+#define memcpy_P                 memcpy
+#define strlen_P                 strlen
+#define strcpy_P                 strcpy
+#define strcmp_P                 strcmp
+
+#endif // HOST_AVR_PGMSPACE_H
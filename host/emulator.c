@@ -0,0 +1,560 @@
+/*
+ * emulator.c - Run the Whole Firmware (main.c) on Linux
+ *
+ * main.c is linked unchanged (its main() renamed to firmware_main) on top of
+ * the host HAL:
+ * - UART:    a pseudo terminal, open it with any serial terminal program
+ *            (screen, picocom, minicom) and type messages and /commands
+ * - Buttons: keys in this terminal (see below), held down for 100 ms
+ * - Panel:   a model of the panel fed with the real connector signals
+ *            (SPI bytes, A/B, latch, OE), drawn with block characters.
+ *            Rows that are not refreshed for 20 ms go dark, like the LEDs.
+ *            Built with PANEL_DEFS="-DDISPLAY_PANELS_WIDE=4
+ *            -DDISPLAY_PANELS_HIGH=2" (see the Makefile) it is a wall, and
+ *            every panel sits where main.c's DISPLAY_CHAIN map says.
+ * - Time:    the firmware's _delay_ms()/_delay_us() run in real time
+ *            (or faster with --speed / --fast)
+ * - Light:   the sensor on PA0 (ambient_light.h) reads --light N (0-1023,
+ *            default 512); [ and ] change it while running. The status line
+ *            shows the LED on-time per phase the firmware picked.
+ *
+ * The status line shows the refresh rate the firmware reaches and how much
+ * host CPU time the code between two waits takes per frame (clear, draw,
+ * 4 scan phases). That is a dev box number, not AVR cycles: use it to
+ * compare content and effects, and bench/cycle_bench.c for the real budget.
+ *
+ * Keys:
+ *   +  PC0 speed up       -  PC1 speed down     d  PC2 direction
+ *   w  PC6 text up        s  PC7 text down      (arrow up/down work too)
+ *   [  darker             ]  brighter (light sensor, steps of 64)
+ *   q  quit
+ *
+ * Replay (see input_trace.h):
+ *   --replay FILE plays back the output of the "/trace" command (a serial
+ *   log with other text around it is fine): every UART byte and button
+ *   change happens at its recorded time since reset, instead of the pty
+ *   and the keys. With --fast the run is fully repeatable, and --uart-log
+ *   saves everything the firmware sent, to compare two runs.
+ *   Input reaches the firmware at its next wait (at most 1 ms late), since
+ *   the host does not interrupt running code. A trace recorded here also
+ *   has no CPU time in it: the firmware takes 0 virtual time between waits.
+ *
+ * Usage:
+ *   ./emulator [--speed X] [--fast] [--seconds N] [--compact]
+ *              [--replay FILE] [--uart-log FILE] [--light N]
+ *   screen /dev/pts/N        (the device is printed at startup)
+ *
+ */
+
+#define _XOPEN_SOURCE 600
+#define _DEFAULT_SOURCE
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+#include <avr/io.h>
+#include "host_hal.h"
+#include "vma419.h"
+
+int firmware_main(void);
+extern VMA419_Display dmd_display;      // main.c: its chain map places the panels
+
+//==============================================================================
+// SETTINGS
+//==============================================================================
+
+#define PANEL_WIDTH      32
+#define PANEL_HEIGHT     16
+#define PANEL_BYTES      16             // bytes per panel and scan phase
+#ifndef DISPLAY_PANELS_WIDE             // same settings as main.c
+#define DISPLAY_PANELS_WIDE 1
+#endif
+#ifndef DISPLAY_PANELS_HIGH
+#define DISPLAY_PANELS_HIGH 1
+#endif
+#define PANELS           (DISPLAY_PANELS_WIDE * DISPLAY_PANELS_HIGH)
+#define DISPLAY_WIDTH    (PANEL_WIDTH * DISPLAY_PANELS_WIDE)
+#define DISPLAY_HEIGHT   (PANEL_HEIGHT * DISPLAY_PANELS_HIGH)
+
+#define ROW_PERSIST_US   20000          // a row not refreshed for this long is dark
+#define BUTTON_HOLD_US   100000         // how long a key press holds a button down
+#define UART_BYTE_US     1042           // one byte at 9600 baud, 8N1
+#define LIGHT_STEP       64             // [ and ] change the light sensor by this
+#define RENDER_NS        40000000L      // redraw the terminal at 25 Hz (wall clock)
+
+// Connector pins, same as dmd_pins in main.c
+#define PIN_A            (1 << PA1)     // PORTA
+#define PIN_B            (1 << PA2)     // PORTA
+#define PIN_LATCH        (1 << PA4)     // PORTA
+#define PIN_OE           (1 << PD7)     // PORTD, active low
+
+static double speed = 1.0;              // virtual seconds per real second
+static int fast = 0;                    // no waiting at all
+static double run_seconds = 0;          // stop after this much virtual time (0 = never)
+static int compact = 0;                 // half-block characters, 2 rows per line
+static FILE* uart_log;                  // copy of everything the firmware sends
+static uint16_t light = 512;            // what the light sensor on PA0 reads
+
+typedef struct {
+    uint32_t time_us;                   // since reset
+    char kind;                          // 'U' or 'B'
+    uint8_t value;
+} ReplayEvent;
+
+static ReplayEvent* replay;             // --replay events, NULL = live input
+static unsigned replay_count, replay_next;
+
+//==============================================================================
+// PANEL MODEL
+//==============================================================================
+// Same rules as tools/scan_decode.py: bytes go into the shift register, a
+// rising latch edge copies them to the outputs, and while OE is low the
+// latched bytes light rows (s+1)%4 + 4k of row select s, in wire order.
+
+static const uint8_t wire_order[PANEL_BYTES][2] = {     // (byte column, k)
+    {0, 3}, {0, 2}, {1, 3}, {1, 2}, {0, 1}, {0, 0}, {1, 1}, {1, 0},
+    {2, 3}, {2, 2}, {3, 3}, {3, 2}, {2, 1}, {2, 0}, {3, 1}, {3, 0},
+};
+
+static uint8_t shift_reg[PANELS * PANEL_BYTES];
+static uint8_t latched[PANELS * PANEL_BYTES];
+static uint8_t port_a, port_d = PIN_OE;
+
+static uint8_t image[DISPLAY_HEIGHT][DISPLAY_WIDTH];
+static uint32_t row_time[DISPLAY_HEIGHT];               // last refresh, virtual us
+static uint8_t row_seen[DISPLAY_HEIGHT];
+
+static unsigned long latch_count;
+static uint32_t oe_on_since, oe_on_us;  // last OE pulse: start and length
+
+static void panel_show(void) {
+    uint8_t select = ((port_a & PIN_A) ? 1 : 0) | ((port_a & PIN_B) ? 2 : 0);
+    uint8_t first_row = (select + 1) % 4;
+
+    for (uint8_t panel = 0; panel < PANELS; panel++) {
+        // Where this chain position is mounted (host "flash" is plain memory)
+        uint8_t column = panel % DISPLAY_PANELS_WIDE, tile_row = panel / DISPLAY_PANELS_WIDE, turn = 0;
+        if (dmd_display.chain) {
+            column = dmd_display.chain[panel].column;
+            tile_row = dmd_display.chain[panel].row;
+            turn = dmd_display.chain[panel].orientation;
+        }
+        for (uint8_t i = 0; i < PANEL_BYTES; i++) {
+            uint8_t byte = latched[panel * PANEL_BYTES + i];
+            uint8_t y = first_row + 4 * wire_order[i][1];
+            if (turn & VMA419_ORIENT_MIRROR_Y) y = PANEL_HEIGHT - 1 - y;
+            uint16_t row = tile_row * PANEL_HEIGHT + y;
+            for (uint8_t bit = 0; bit < 8; bit++) {
+                uint8_t x = wire_order[i][0] * 8 + bit;
+                if (turn & VMA419_ORIENT_MIRROR_X) x = PANEL_WIDTH - 1 - x;
+                image[row][column * PANEL_WIDTH + x] = (byte >> (7 - bit)) & 1;
+            }
+            row_time[row] = host_time_us;
+            row_seen[row] = 1;
+        }
+    }
+}
+
+static void on_signal(const char* signal, uint8_t value) {
+    if (strcmp(signal, "SPDR") == 0) {
+        memmove(shift_reg, shift_reg + 1, sizeof(shift_reg) - 1);
+        shift_reg[sizeof(shift_reg) - 1] = value;
+        return;
+    }
+
+    uint8_t old_a = port_a, old_d = port_d;
+    if (strcmp(signal, "PORTA") == 0) port_a = value;
+    else if (strcmp(signal, "PORTD") == 0) port_d = value;
+    else return;
+
+    int latch_edge = (port_a & PIN_LATCH) && !(old_a & PIN_LATCH);
+    int enabled = !(port_d & PIN_OE);
+    int was_enabled = !(old_d & PIN_OE);
+    int select_changed = (port_a ^ old_a) & (PIN_A | PIN_B);
+
+    if (latch_edge) {
+        memcpy(latched, shift_reg, sizeof(latched));
+        latch_count++;
+    }
+    if (enabled && (!was_enabled || select_changed || latch_edge)) {
+        panel_show();
+    }
+    if (enabled && !was_enabled) oe_on_since = host_time_us;
+    if (!enabled && was_enabled) oe_on_us = host_time_us - oe_on_since;
+}
+
+static uint16_t light_sensor(uint8_t channel) {
+    return light;
+}
+
+//==============================================================================
+// TERMINAL
+//==============================================================================
+
+static struct termios saved_termios;
+static int termios_saved = 0;
+
+static void terminal_restore(void) {
+    if (termios_saved) tcsetattr(STDIN_FILENO, TCSANOW, &saved_termios);
+    printf("\033[0m\033[?25h\n");       // colors off, cursor back
+    fflush(stdout);
+}
+
+// Keys without Enter and without echo; stdin may also be a pipe (scripted keys)
+static void terminal_raw(void) {
+    fcntl(STDIN_FILENO, F_SETFL, fcntl(STDIN_FILENO, F_GETFL) | O_NONBLOCK);
+    if (!isatty(STDIN_FILENO) || tcgetattr(STDIN_FILENO, &saved_termios) != 0) return;
+    termios_saved = 1;
+    struct termios t = saved_termios;
+    t.c_lflag &= ~(ICANON | ECHO);
+    t.c_cc[VMIN] = 0;
+    t.c_cc[VTIME] = 0;
+    tcsetattr(STDIN_FILENO, TCSANOW, &t);
+}
+
+static char uart_line[61];              // tail of what the firmware sent
+static const char* pty_name = "";
+
+static void uart_line_add(uint8_t byte) {
+    size_t len = strlen(uart_line);
+    if (byte == '\n' || byte == '\r') {
+        if (byte == '\n') uart_line[0] = '\0';
+        return;
+    }
+    if (byte < 32 || byte > 126) byte = '.';
+    if (len == sizeof(uart_line) - 1) {
+        memmove(uart_line, uart_line + 1, len);
+        len--;
+    }
+    uart_line[len] = (char)byte;
+    uart_line[len + 1] = '\0';
+}
+
+//==============================================================================
+// STATISTICS (host CPU time spent between two waits)
+//==============================================================================
+
+static struct timespec wall_start;
+static long long busy_ns, frame_busy_ns, frame_busy_max_ns, frame_busy_sum_ns;
+static unsigned long frames, frames_at_status;
+static uint32_t status_time_us;
+static double refresh_hz, busy_us_per_frame;
+
+static long long now_ns(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (long long)(t.tv_sec - wall_start.tv_sec) * 1000000000LL + (t.tv_nsec - wall_start.tv_nsec);
+}
+
+static void render(void) {
+    uint32_t now = host_time_us;
+    printf("\033[H");                   // top left, draw over the last picture
+
+    for (uint16_t y = 0; y < DISPLAY_HEIGHT; y += compact ? 2 : 1) {
+        for (uint16_t x = 0; x < DISPLAY_WIDTH; x++) {
+            uint8_t top = row_seen[y] && now - row_time[y] < ROW_PERSIST_US && image[y][x];
+            if (compact) {
+                uint16_t y2 = y + 1;
+                uint8_t bottom = row_seen[y2] && now - row_time[y2] < ROW_PERSIST_US && image[y2][x];
+                static const char* const halves[4] = { "\033[90m.", "\033[31m\xe2\x96\x80", "\033[31m\xe2\x96\x84", "\033[31m\xe2\x96\x88" };
+                fputs(halves[top | bottom << 1], stdout);
+            } else {
+                fputs(top ? "\033[31m\xe2\x96\x88\xe2\x96\x88" : "\033[90m .", stdout);
+            }
+        }
+        fputs("\033[0m\033[K\n", stdout);
+    }
+    printf("\033[K\n");
+    printf("t=%7.2fs  refresh %5.1f Hz  host CPU avg %6.1f us/frame, max %.1f\033[K\n",
+           now / 1e6, refresh_hz, busy_us_per_frame, frame_busy_max_ns / 1e3);
+    printf("light %4u/1023  LEDs on %4lu us per phase\033[K\n", light, (unsigned long)oe_on_us);
+    if (replay) {
+        printf("UART replay %u/%u: %s\033[K\n", replay_next, replay_count, uart_line);
+    } else {
+        printf("UART %s: %s\033[K\n", pty_name, uart_line);
+    }
+    printf("keys: + - d w s (buttons)  [ ] light  q quit\033[K\n");
+    fflush(stdout);
+}
+
+static void print_summary(void) {
+    fprintf(stderr, "%lu frames in %.2f s virtual time, host CPU per frame: avg %.1f us, max %.1f us\n",
+            frames, host_time_us / 1e6,
+            frames ? frame_busy_sum_ns / 1e3 / frames : 0.0, frame_busy_max_ns / 1e3);
+}
+
+//==============================================================================
+// UART ON A PSEUDO TERMINAL
+//==============================================================================
+
+static int pty_fd = -1;
+static uint8_t rx_queue[256];
+static unsigned rx_count;
+static uint32_t rx_next_us;
+
+static void pty_open(void) {
+    pty_fd = posix_openpt(O_RDWR | O_NOCTTY);
+    if (pty_fd < 0 || grantpt(pty_fd) != 0 || unlockpt(pty_fd) != 0) {
+        perror("pty");
+        exit(2);
+    }
+    pty_name = ptsname(pty_fd);
+
+    // Keep the other end open ourselves, so the pty survives a terminal
+    // program coming and going, and make it a raw serial line
+    int slave = open(pty_name, O_RDWR | O_NOCTTY);
+    if (slave >= 0) {
+        struct termios t;
+        tcgetattr(slave, &t);
+        cfmakeraw(&t);
+        tcsetattr(slave, TCSANOW, &t);
+    }
+    fcntl(pty_fd, F_SETFL, fcntl(pty_fd, F_GETFL) | O_NONBLOCK);
+}
+
+static void uart_tx(uint8_t byte) {
+    uart_line_add(byte);
+    if (uart_log) fputc(byte, uart_log);
+    if (write(pty_fd, &byte, 1) < 0 && errno != EAGAIN) {
+        // Nobody is reading: drop it, like a serial line with nothing attached
+    }
+}
+
+// Hand over received bytes no faster than 9600 baud allows
+static void uart_poll(void) {
+    if (rx_count < sizeof(rx_queue)) {
+        ssize_t n = read(pty_fd, rx_queue + rx_count, sizeof(rx_queue) - rx_count);
+        if (n > 0) rx_count += (unsigned)n;
+    }
+    while (rx_count > 0 && (int32_t)(host_time_us - rx_next_us) >= 0) {
+        uint8_t byte = rx_queue[0];
+        memmove(rx_queue, rx_queue + 1, --rx_count);
+        host_uart_receive(byte);
+        rx_next_us = host_time_us + UART_BYTE_US;
+    }
+    if (rx_count == 0 && (int32_t)(host_time_us - rx_next_us) > 0) rx_next_us = host_time_us;
+}
+
+//==============================================================================
+// REPLAY OF A /trace DUMP
+//==============================================================================
+
+#define BUTTON_PINS  ((1 << PC0) | (1 << PC1) | (1 << PC2) | (1 << PC6) | (1 << PC7))
+
+// Lines "<U|B|W> <4 hex digits> <2 hex digits>", everything else is skipped
+static void replay_load(const char* path) {
+    FILE* f = fopen(path, "r");
+    if (!f) {
+        perror(path);
+        exit(2);
+    }
+    char line[128];
+    uint64_t ticks = 0;
+    unsigned capacity = 0;
+
+    while (fgets(line, sizeof(line), f)) {
+        char kind;
+        unsigned gap, value;
+        char end;
+        if (sscanf(line, " %c %4x %2x%c", &kind, &gap, &value, &end) != 4 || (end != '\r' && end != '\n')) continue;
+        if (kind == 'W') {
+            ticks += (uint64_t)gap << 16;
+            continue;
+        }
+        if (kind != 'U' && kind != 'B') continue;
+        ticks += gap;
+
+        if (replay_count == capacity) {
+            capacity = capacity ? capacity * 2 : 64;
+            replay = realloc(replay, capacity * sizeof(*replay));
+            if (!replay) exit(2);
+        }
+        replay[replay_count].time_us = (uint32_t)(ticks * 8);    // INPUT_TRACE_TICK_US
+        replay[replay_count].kind = kind;
+        replay[replay_count].value = (uint8_t)value;
+        replay_count++;
+    }
+    fclose(f);
+    if (replay_count == 0) {
+        fprintf(stderr, "%s: no trace records found\n", path);
+        exit(2);
+    }
+}
+
+static void replay_poll(void) {
+    while (replay_next < replay_count && (int32_t)(host_time_us - replay[replay_next].time_us) >= 0) {
+        const ReplayEvent* e = &replay[replay_next++];
+        if (e->kind == 'U') {
+            host_uart_receive(e->value);
+        } else {
+            PINC = e->value | (uint8_t)~BUTTON_PINS;     // unused pins read 1 (pull-ups)
+        }
+    }
+}
+
+//==============================================================================
+// BUTTONS
+//==============================================================================
+
+static uint32_t button_until[8];        // per PINC bit: pressed until this time
+static uint8_t button_held;
+
+static void button_press(uint8_t bit) {
+    button_until[bit] = host_time_us + BUTTON_HOLD_US;
+    button_held |= (1 << bit);
+}
+
+static void keys_poll(void) {
+    static uint8_t escape;              // position inside an arrow key sequence
+    uint8_t key;
+
+    while (read(STDIN_FILENO, &key, 1) == 1) {
+        if (escape == 1) { escape = (key == '[') ? 2 : 0; continue; }
+        if (escape == 2) {
+            escape = 0;
+            if (key == 'A') button_press(PC6);
+            if (key == 'B') button_press(PC7);
+            continue;
+        }
+        switch (key) {
+            case 27:            escape = 1; break;
+            case '+': case '=': button_press(PC0); break;
+            case '-': case '_': button_press(PC1); break;
+            case 'd': case 'D': button_press(PC2); break;
+            case 'w': case 'W': button_press(PC6); break;
+            case 's': case 'S': button_press(PC7); break;
+            case '[':           light = (light > LIGHT_STEP) ? light - LIGHT_STEP : 0; break;
+            case ']':           light = (light + LIGHT_STEP < 1023) ? light + LIGHT_STEP : 1023; break;
+            case 'q': case 'Q': case 3:
+                print_summary();
+                exit(0);
+        }
+    }
+
+    if (replay) return;                 // the buttons come from the trace
+
+    // Released buttons read 1 (pull-ups), pressed ones 0
+    for (uint8_t bit = 0; bit < 8; bit++) {
+        if ((button_held & (1 << bit)) && (int32_t)(host_time_us - button_until[bit]) >= 0) {
+            button_held &= ~(1 << bit);
+        }
+    }
+    PINC = (uint8_t)~button_held;
+}
+
+//==============================================================================
+// THE WAIT HOOK
+//==============================================================================
+// Everything between two waits is firmware work; the hook itself (sleeping,
+// input, drawing) is not counted.
+
+static long long hook_left_ns;
+static long long last_render_ns = -RENDER_NS;
+
+static void on_delay(void) {
+    long long entered = now_ns();
+    busy_ns = entered - hook_left_ns;
+    frame_busy_ns += busy_ns;
+
+    // A frame ends with the 4th latch
+    if (latch_count >= 4 * (frames + 1)) {
+        frames = latch_count / 4;
+        frame_busy_sum_ns += frame_busy_ns;
+        if (frame_busy_ns > frame_busy_max_ns) frame_busy_max_ns = frame_busy_ns;
+        frame_busy_ns = 0;
+    }
+
+    if (replay) {
+        replay_poll();
+    } else {
+        uart_poll();
+    }
+    keys_poll();
+
+    // Keep virtual time in step with the wall clock
+    if (!fast) {
+        long long target = (long long)(host_time_us / speed * 1000.0);
+        long long ahead = target - now_ns();
+        if (ahead > 0) {
+            struct timespec t = { ahead / 1000000000LL, ahead % 1000000000LL };
+            nanosleep(&t, NULL);
+        }
+    }
+
+    // Refresh rate over the last half second of virtual time
+    uint32_t span = host_time_us - status_time_us;
+    if (span >= 500000) {
+        refresh_hz = (frames - frames_at_status) * 1e6 / span;
+        busy_us_per_frame = frames ? frame_busy_sum_ns / 1e3 / frames : 0.0;
+        frames_at_status = frames;
+        status_time_us = host_time_us;
+    }
+
+    long long now = now_ns();
+    if (now - last_render_ns >= RENDER_NS) {
+        render();
+        last_render_ns = now;
+    }
+
+    if (run_seconds > 0 && host_time_us >= run_seconds * 1e6) {
+        render();
+        print_summary();
+        exit(0);
+    }
+    hook_left_ns = now_ns();
+}
+
+//==============================================================================
+// MAIN
+//==============================================================================
+
+int main(int argc, char** argv) {
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--speed") == 0 && i + 1 < argc) {
+            speed = atof(argv[++i]);
+            if (speed <= 0) speed = 1.0;
+        } else if (strcmp(argv[i], "--fast") == 0) {
+            fast = 1;
+        } else if (strcmp(argv[i], "--seconds") == 0 && i + 1 < argc) {
+            run_seconds = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--compact") == 0) {
+            compact = 1;
+        } else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            replay_load(argv[++i]);
+        } else if (strcmp(argv[i], "--light") == 0 && i + 1 < argc) {
+            light = (uint16_t)atoi(argv[++i]);
+            if (light > 1023) light = 1023;
+        } else if (strcmp(argv[i], "--uart-log") == 0 && i + 1 < argc) {
+            uart_log = fopen(argv[++i], "wb");
+            if (!uart_log) {
+                perror(argv[i]);
+                return 2;
+            }
+        } else {
+            fprintf(stderr, "Usage: %s [--speed X] [--fast] [--seconds N] [--compact]"
+                            " [--replay FILE] [--uart-log FILE] [--light N]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &wall_start);
+    pty_open();
+    terminal_raw();
+    atexit(terminal_restore);
+    printf("\033[2J\033[?25l");         // clear the screen, hide the cursor
+
+    host_reset();
+    PINC = 0xFF;                        // no button pressed
+    host_uart_set_output(uart_tx);
+    host_adc_set_input(light_sensor);
+    host_set_event_hook(on_signal);
+    host_set_delay_hook(on_delay);
+    hook_left_ns = now_ns();
+
+    return firmware_main();             // never returns, 'q' or --seconds exit
+}
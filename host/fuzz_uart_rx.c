@@ -0,0 +1,354 @@
+/*
+ * fuzz_uart_rx.c - Fuzz the UART Receive Path of main.c (host build)
+ *
+ * Feeds arbitrary bytes into the real ISR(USART_RXC_vect) from main.c, one
+ * host_uart_receive() per byte, and plays the main loop's part in between:
+ * uart_message_available() / uart_get_message() and then
+ * handleUartCommand() or updateDisplayMessage(), like main() does.
+ *
+ * After every byte it checks:
+ * - the ring indices stay inside uart_rx_buffer[]
+ * - the line held in the ring, the echo sent back and the finished message
+ *   match a simple model of the line editor (printable characters and UTF-8
+ *   bytes append, BS/DEL remove one whole character, CR/LF finish a
+ *   non-empty line, everything else is ignored)
+ * - the message handed to the main loop is the model's line decoded from
+ *   UTF-8 to Latin-1 (utf8_latin1.h), by a decoder written separately here
+ * - uart_message and scroll_text are always terminated and printable
+ *   (scroll_text in Latin-1: 32-126 and 161-255)
+ * Memory errors and undefined behaviour are left to the sanitizers.
+ *
+ * The first input byte chooses how often the "main loop" looks for a
+ * message (0 = only at the end), so several lines can arrive before one is
+ * read, as at a high baud rate with a slow main loop.
+ *
+ * Builds (see Makefile):
+ *   make fuzz_uart_rx             gcc/clang + AddressSanitizer + UBSan,
+ *                                 with its own random driver (below)
+ *   make fuzz_uart_rx_libfuzzer   clang -fsanitize=fuzzer (libFuzzer)
+ * The plain build also works with AFL: afl-clang-fast, then
+ *   afl-fuzz -i in -o out ./fuzz_uart_rx @@
+ *
+ * Usage (plain build):
+ *   ./fuzz_uart_rx                run the random driver (default 20000 inputs)
+ *   ./fuzz_uart_rx -runs=N -seed=S
+ *   ./fuzz_uart_rx FILE...        run the given inputs once each (- = stdin)
+ * A failing input is written to fuzz_uart_rx.crash before aborting.
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include "host_hal.h"
+#include "../utf8_latin1.h"
+
+//==============================================================================
+// FIRMWARE UNDER TEST (main.c, built with -Dmain=firmware_main)
+//==============================================================================
+
+#define UART_BUFFER_SIZE 64             // must match main.c
+
+extern volatile char uart_rx_buffer[UART_BUFFER_SIZE];
+extern volatile uint8_t uart_rx_head;
+extern volatile uint8_t uart_rx_tail;
+extern volatile uint8_t uart_message_ready;
+extern char uart_message[32];
+extern char scroll_text[32];
+
+void USART_Init(unsigned int ubrr);
+uint8_t uart_message_available(void);
+void uart_get_message(char* buffer, uint8_t max_length);
+uint8_t handleUartCommand(const char* message);
+void updateDisplayMessage(const char* message);
+
+//==============================================================================
+// REFERENCE MODEL OF THE LINE EDITOR
+//==============================================================================
+
+typedef struct {
+    char line[UART_BUFFER_SIZE];        // what has been typed so far
+    uint8_t length;
+    char message[32];                   // last finished line (first 31 bytes, whole characters)
+    uint8_t ready;
+    char echo[8];                       // what the ISR should send back
+    uint8_t echo_length;
+} LineModel;
+
+static void model_receive(LineModel* m, uint8_t byte) {
+    m->echo_length = 0;
+    m->echo[m->echo_length++] = (char)byte;
+
+    if (byte == '\r' || byte == '\n') {
+        if (m->length > 0) {
+            uint8_t n = (m->length < sizeof(m->message) - 1) ? m->length : sizeof(m->message) - 1;
+            while (n > 0 && n < m->length && ((uint8_t)m->line[n] & 0xC0) == 0x80) n--;
+            memcpy(m->message, m->line, n);
+            m->message[n] = '\0';
+            m->ready = 1;
+            m->length = 0;
+            m->echo[m->echo_length++] = '\r';
+            m->echo[m->echo_length++] = '\n';
+        }
+    } else if (byte == 8 || byte == 127) {
+        if (m->length > 0) {
+            while (--m->length > 0 && ((uint8_t)m->line[m->length] & 0xC0) == 0x80) {}
+            memcpy(m->echo + m->echo_length, "\b \b", 3);
+            m->echo_length += 3;
+        }
+    } else if (byte >= 32) {
+        if (m->length < UART_BUFFER_SIZE - 1) {     // one slot stays free in the ring
+            m->line[m->length++] = (char)byte;
+        }
+    }
+}
+
+// What uart_get_message() should return for a line: one Latin-1 character
+// per UTF-8 sequence, '?' for every broken sequence or stray byte
+static void model_decode(char* out, const char* line, size_t size) {
+    const uint8_t* s = (const uint8_t*)line;
+    size_t n = 0;
+
+    while (*s && n < size - 1) {
+        uint8_t lead = *s;
+        int need = (lead >= 0xC2 && lead <= 0xDF) ? 1 :
+                   (lead >= 0xE0 && lead <= 0xEF) ? 2 :
+                   (lead >= 0xF0 && lead <= 0xF4) ? 3 : 0;
+        if (lead < 0x80) {
+            out[n++] = (lead >= 32 && lead <= 126) ? (char)lead : '?';
+            s++;
+            continue;
+        }
+        if (need == 0) {
+            out[n++] = '?';
+            s++;
+            continue;
+        }
+        int got = 0;
+        uint32_t code_point = lead & (0x3F >> need);
+        while (got < need && (s[1 + got] & 0xC0) == 0x80) {
+            code_point = (code_point << 6) | (s[1 + got] & 0x3F);
+            got++;
+        }
+        out[n++] = (got < need) ? '?' : (char)latin1_from_code_point(code_point);
+        s += 1 + got;
+    }
+    out[n] = '\0';
+}
+
+//==============================================================================
+// CHECKS
+//==============================================================================
+
+static const uint8_t* current_input;
+static size_t current_size;
+static size_t current_offset;
+
+static void fail(const char* what) {
+    fprintf(stderr, "fuzz_uart_rx: %s (input byte %lu of %lu)\n",
+            what, (unsigned long)current_offset, (unsigned long)current_size);
+    FILE* f = fopen("fuzz_uart_rx.crash", "wb");
+    if (f) {
+        fwrite(current_input, 1, current_size, f);
+        fclose(f);
+        fprintf(stderr, "fuzz_uart_rx: input written to fuzz_uart_rx.crash\n");
+    }
+    abort();
+}
+
+// A string of at most 'size' - 1 printable characters, terminated inside 'size';
+// bytes above 126 must be 'high_from' or more
+static void check_string(const char* s, size_t size, uint8_t high_from, const char* what) {
+    const char* end = memchr(s, '\0', size);
+    if (!end) fail(what);
+    for (const uint8_t* p = (const uint8_t*)s; p < (const uint8_t*)end; p++) {
+        if (*p < 32 || (*p > 126 && *p < high_from)) fail(what);
+    }
+}
+
+static uint8_t echo[64];
+static uint8_t echo_length;
+
+static void collect_echo(uint8_t byte) {
+    if (echo_length < sizeof(echo)) echo[echo_length++] = byte;
+}
+
+static void check_state(const LineModel* m) {
+    uint8_t head = uart_rx_head, tail = uart_rx_tail;
+    if (head >= UART_BUFFER_SIZE || tail >= UART_BUFFER_SIZE) fail("ring index out of range");
+
+    uint8_t length = (uint8_t)((head - tail + UART_BUFFER_SIZE) % UART_BUFFER_SIZE);
+    if (length != m->length) fail("line length differs from the model");
+    for (uint8_t i = 0; i < length; i++) {
+        if (uart_rx_buffer[(tail + i) % UART_BUFFER_SIZE] != m->line[i]) fail("line content differs from the model");
+    }
+
+    if (uart_message_ready != m->ready) fail("message ready flag differs from the model");
+    check_string(uart_message, sizeof(uart_message), 0x80, "uart_message not terminated or not printable");
+    if (m->ready && strcmp(uart_message, m->message) != 0) fail("message differs from the model");
+
+    if (echo_length != m->echo_length || memcmp(echo, m->echo, echo_length) != 0) fail("echo differs from the model");
+}
+
+// The main loop's message handling
+static void main_loop_poll(LineModel* m) {
+    if (!uart_message_available()) return;
+
+    char new_message[32], expected[32];
+    uart_get_message(new_message, sizeof(new_message));
+    model_decode(expected, m->message, sizeof(expected));
+    if (strcmp(new_message, expected) != 0) fail("uart_get_message() differs from the model");
+    m->ready = 0;
+
+    host_uart_set_output(NULL);
+    if (!handleUartCommand(new_message)) {
+        updateDisplayMessage(new_message);
+        check_string(scroll_text, sizeof(scroll_text), 0xA1, "scroll_text not terminated or not printable");
+    }
+    host_uart_set_output(collect_echo);
+}
+
+//==============================================================================
+// FUZZ TARGET
+//==============================================================================
+
+int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    current_input = data;
+    current_size = size;
+    if (size == 0) return 0;
+
+    // Power-on state of the receive path
+    host_reset();
+    uart_rx_head = 0;
+    uart_rx_tail = 0;
+    uart_message_ready = 0;
+    memset(uart_message, 0, sizeof(uart_message));
+    USART_Init(51);
+    host_uart_set_output(collect_echo);
+
+    LineModel model;
+    memset(&model, 0, sizeof(model));
+    uint8_t poll_every = data[0] & 0x0F;
+
+    for (current_offset = 1; current_offset < size; current_offset++) {
+        echo_length = 0;
+        model_receive(&model, data[current_offset]);
+        host_uart_receive(data[current_offset]);
+        host_flush();
+        check_state(&model);
+
+        if (poll_every && current_offset % poll_every == 0) {
+            main_loop_poll(&model);
+            check_state(&model);
+        }
+    }
+    main_loop_poll(&model);
+
+    host_uart_set_output(NULL);
+    return 0;
+}
+
+//==============================================================================
+// STANDALONE DRIVER (not used with libFuzzer)
+//==============================================================================
+
+#ifndef FUZZ_LIBFUZZER
+
+static uint32_t rng_state;
+
+static uint32_t rng_next(void) {       // xorshift32
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+// Bytes the line editor treats specially come up much more often than chance
+static uint8_t random_byte(void) {
+    static const uint8_t special[] = { '\r', '\n', 8, 127, '/', ' ', 0, 0x80, 0xFF, 27,
+                                       0xC3, 0xC4, 0xC5, 0xE2, 0xF0, 0xA0, 0xBF };
+    uint32_t r = rng_next();
+    switch (r & 3) {
+        case 0:  return special[(r >> 8) % sizeof(special)];
+        case 1:  return (uint8_t)(r >> 8);
+        default: return (uint8_t)(32 + (r >> 8) % 95);
+    }
+}
+
+static size_t random_input(uint8_t* buf, size_t max) {
+    static const char* const seeds[] = {
+        "/stats\r", "/trace\r", "/light\r", "/nope\n", "HELLO\r\n", "AB\b\b\b\bC\r", "\r\r\n\n",
+        "Ana Mari\xc4\x87\r", "\xc5\xbd\xc3\xa9\b\xe2\x82\xac\r", "\xf0\x9f\x98\x80\xc3\r",
+    };
+    size_t size = 1 + rng_next() % (max - 1);
+    buf[0] = (uint8_t)rng_next();
+    for (size_t i = 1; i < size; i++) buf[i] = random_byte();
+
+    // Long runs overflow the 63-byte line and the 31-byte message; runs of
+    // "é" (0xC3 0xA9) make the message end in the middle of a character
+    if ((rng_next() & 3) == 0) {
+        size_t at = 1 + rng_next() % size, run = rng_next() % 100;
+        uint32_t kind = rng_next() % 3;
+        uint8_t byte = (kind == 0) ? 'A' + rng_next() % 26 : 8;
+        for (size_t i = at; i < at + run && i < max; i++) {
+            buf[i] = (kind == 2) ? (((i - at) & 1) ? 0xA9 : 0xC3) : byte;
+        }
+        if (at + run > size) size = (at + run < max) ? at + run : max;
+    }
+    // Splice in a known line
+    if ((rng_next() & 3) == 0) {
+        const char* seed = seeds[rng_next() % (sizeof(seeds) / sizeof(seeds[0]))];
+        size_t len = strlen(seed), at = 1 + rng_next() % size;
+        if (at + len <= max) {
+            memcpy(buf + at, seed, len);
+            if (at + len > size) size = at + len;
+        }
+    }
+    return size;
+}
+
+static int run_file(const char* path) {
+    FILE* f = (strcmp(path, "-") == 0) ? stdin : fopen(path, "rb");
+    if (!f) {
+        perror(path);
+        return 1;
+    }
+    static uint8_t buf[1 << 16];
+    size_t size = fread(buf, 1, sizeof(buf), f);
+    if (f != stdin) fclose(f);
+    LLVMFuzzerTestOneInput(buf, size);
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    unsigned long runs = 20000;
+    uint32_t seed = 1;
+    int files = 0, status = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "-runs=", 6) == 0) {
+            runs = strtoul(argv[i] + 6, NULL, 0);
+        } else if (strncmp(argv[i], "-seed=", 6) == 0) {
+            seed = (uint32_t)strtoul(argv[i] + 6, NULL, 0);
+        } else if (argv[i][0] == '-' && argv[i][1] != '\0') {
+            fprintf(stderr, "Usage: %s [-runs=N] [-seed=S] [FILE...]\n", argv[0]);
+            return 2;
+        } else {
+            status |= run_file(argv[i]);
+            files++;
+        }
+    }
+    if (files) return status;
+
+    static uint8_t buf[1024];
+    rng_state = seed ? seed : 1;
+    for (unsigned long n = 0; n < runs; n++) {
+        LLVMFuzzerTestOneInput(buf, random_input(buf, sizeof(buf)));
+    }
+    printf("fuzz_uart_rx: %lu random inputs, no failures (seed %lu)\n", runs, (unsigned long)seed);
+    return 0;
+}
+
+#endif // FUZZ_LIBFUZZER
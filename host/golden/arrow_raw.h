@@ -0,0 +1,38 @@
+/*
+ * arrow_raw.h - golden_arrow_raw, 21x12 pixels
+ *
+ * Generated by tools/bitmap_compile.py from arrow.pbm, do not edit.
+ * Format RAW, 40 bytes of flash (4 of them header). Draw it with
+ *   vma419_draw_bitmap_P(&display, x, y, golden_arrow_raw);
+ *
+ *   .....................
+ *   .....................
+ *   ..............#......
+ *   ..............###....
+ *   #####################
+ *   #####################
+ *   #####################
+ *   ..............###....
+ *   ..............#......
+ *   .....................
+ *   #.#.#.#.#.#.#.#.#.#.#
+ *   .....................
+ */
+
+#ifndef ARROW_RAW_H
+#define ARROW_RAW_H
+
+#include <stdint.h>
+#include <avr/pgmspace.h>
+
+#define GOLDEN_ARROW_RAW_WIDTH  21
+#define GOLDEN_ARROW_RAW_HEIGHT 12
+
+const uint8_t golden_arrow_raw[] PROGMEM = {
+    0, 21, 0, 12,  // RAW, width 21, height 12
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x03, 0x80,
+    0xff, 0xff, 0xf8, 0xff, 0xff, 0xf8, 0xff, 0xff, 0xf8, 0x00, 0x03, 0x80,
+    0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0xaa, 0xaa, 0xa8, 0x00, 0x00, 0x00,
+};
+
+#endif // ARROW_RAW_H
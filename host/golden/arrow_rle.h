@@ -0,0 +1,38 @@
+/*
+ * arrow_rle.h - golden_arrow_rle, 21x12 pixels
+ *
+ * Generated by tools/bitmap_compile.py from arrow.pbm, do not edit.
+ * Format RLE, 34 bytes of flash (4 of them header). Draw it with
+ *   vma419_draw_bitmap_P(&display, x, y, golden_arrow_rle);
+ *
+ *   .....................
+ *   .....................
+ *   ..............#......
+ *   ..............###....
+ *   #####################
+ *   #####################
+ *   #####################
+ *   ..............###....
+ *   ..............#......
+ *   .....................
+ *   #.#.#.#.#.#.#.#.#.#.#
+ *   .....................
+ */
+
+#ifndef ARROW_RLE_H
+#define ARROW_RLE_H
+
+#include <stdint.h>
+#include <avr/pgmspace.h>
+
+#define GOLDEN_ARROW_RLE_WIDTH  21
+#define GOLDEN_ARROW_RLE_HEIGHT 12
+
+const uint8_t golden_arrow_rle[] PROGMEM = {
+    2, 21, 0, 12,  // RLE, width 21, height 12
+    0x84, 0x00, 0x12, 0x02, 0x00, 0x00, 0x03, 0x80, 0xff, 0xff, 0xf8, 0xff,
+    0xff, 0xf8, 0xff, 0xff, 0xf8, 0x00, 0x03, 0x80, 0x00, 0x02, 0x81, 0x00,
+    0x02, 0xaa, 0xaa, 0xa8, 0x80, 0x00,
+};
+
+#endif // ARROW_RLE_H
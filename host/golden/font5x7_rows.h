@@ -0,0 +1,906 @@
+/*
+ * font5x7_rows.h - golden_font5x7_rows, row font for vma419_draw_text_P()
+ *
+ * Generated by tools/font_compile.py from VMA419_Font.h, do not edit.
+ * 7 pixels high, 95 glyphs, 954 bytes of flash.
+ *
+ */
+
+#ifndef FONT5X7_ROWS_H
+#define FONT5X7_ROWS_H
+
+#include <stdint.h>
+#include <avr/pgmspace.h>
+
+#define GOLDEN_FONT5X7_ROWS_HEIGHT     7
+#define GOLDEN_FONT5X7_ROWS_FIRST_CHAR 32
+#define GOLDEN_FONT5X7_ROWS_CHAR_COUNT 95
+
+const uint8_t golden_font5x7_rows[] PROGMEM = {
+    7, 32, 95, 1,  // height, first char, char count, spacing
+
+    // widths
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+
+    // offsets (low, high)
+    0x00, 0x00, 0x07, 0x00, 0x0e, 0x00, 0x15, 0x00, 0x1c, 0x00, 0x23, 0x00,
+    0x2a, 0x00, 0x31, 0x00, 0x38, 0x00, 0x3f, 0x00, 0x46, 0x00, 0x4d, 0x00,
+    0x54, 0x00, 0x5b, 0x00, 0x62, 0x00, 0x69, 0x00, 0x70, 0x00, 0x77, 0x00,
+    0x7e, 0x00, 0x85, 0x00, 0x8c, 0x00, 0x93, 0x00, 0x9a, 0x00, 0xa1, 0x00,
+    0xa8, 0x00, 0xaf, 0x00, 0xb6, 0x00, 0xbd, 0x00, 0xc4, 0x00, 0xcb, 0x00,
+    0xd2, 0x00, 0xd9, 0x00, 0xe0, 0x00, 0xe7, 0x00, 0xee, 0x00, 0xf5, 0x00,
+    0xfc, 0x00, 0x03, 0x01, 0x0a, 0x01, 0x11, 0x01, 0x18, 0x01, 0x1f, 0x01,
+    0x26, 0x01, 0x2d, 0x01, 0x34, 0x01, 0x3b, 0x01, 0x42, 0x01, 0x49, 0x01,
+    0x50, 0x01, 0x57, 0x01, 0x5e, 0x01, 0x65, 0x01, 0x6c, 0x01, 0x73, 0x01,
+    0x7a, 0x01, 0x81, 0x01, 0x88, 0x01, 0x8f, 0x01, 0x96, 0x01, 0x9d, 0x01,
+    0xa4, 0x01, 0xab, 0x01, 0xb2, 0x01, 0xb9, 0x01, 0xc0, 0x01, 0xc7, 0x01,
+    0xce, 0x01, 0xd5, 0x01, 0xdc, 0x01, 0xe3, 0x01, 0xea, 0x01, 0xf1, 0x01,
+    0xf8, 0x01, 0xff, 0x01, 0x06, 0x02, 0x0d, 0x02, 0x14, 0x02, 0x1b, 0x02,
+    0x22, 0x02, 0x29, 0x02, 0x30, 0x02, 0x37, 0x02, 0x3e, 0x02, 0x45, 0x02,
+    0x4c, 0x02, 0x53, 0x02, 0x5a, 0x02, 0x61, 0x02, 0x68, 0x02, 0x6f, 0x02,
+    0x76, 0x02, 0x7d, 0x02, 0x84, 0x02, 0x8b, 0x02, 0x92, 0x02,
+
+    // 0x20, 5 px
+    0x00,                    // .....
+    0x00,                    // .....
+    0x00,                    // .....
+    0x00,                    // .....
+    0x00,                    // .....
+    0x00,                    // .....
+    0x00,                    // .....
+
+    // '!', 5 px
+    0x20,                    // ..#..
+    0x20,                    // ..#..
+    0x20,                    // ..#..
+    0x20,                    // ..#..
+    0x20,                    // ..#..
+    0x00,                    // .....
+    0x20,                    // ..#..
+
+    // '"', 5 px
+    0x50,                    // .#.#.
+    0x50,                    // .#.#.
+    0x50,                    // .#.#.
+    0x00,                    // .....
+    0x00,                    // .....
+    0x00,                    // .....
+    0x00,                    // .....
+
+    // '#', 5 px
+    0x50,                    // .#.#.
+    0x50,                    // .#.#.
+    0xf8,                    // #####
+    0x50,                    // .#.#.
+    0xf8,                    // #####
+    0x50,                    // .#.#.
+    0x50,                    // .#.#.
+
+    // '$', 5 px
+    0x20,                    // ..#..
+    0x78,                    // .####
+    0xa0,                    // #.#..
+    0x70,                    // .###.
+    0x28,                    // ..#.#
+    0xf0,                    // ####.
+    0x20,                    // ..#..
+
+    // '%', 5 px
+    0xc0,                    // ##...
+    0xc8,                    // ##..#
+    0x10,                    // ...#.
+    0x20,                    // ..#..
+    0x40,                    // .#...
+    0x98,                    // #..##
+    0x18,                    // ...##
+
+    // '&', 5 px
+    0x60,                    // .##..
+    0x90,                    // #..#.
+    0xa0,                    // #.#..
+    0x40,                    // .#...
+    0xa8,                    // #.#.#
+    0x90,                    // #..#.
+    0x68,                    // .##.#
+
+    // '\'', 5 px
+    0x60,                    // .##..
+    0x20,                    // ..#..
+    0x40,                    // .#...
+    0x00,                    // .....
+    0x00,                    // .....
+    0x00,                    // .....
+    0x00,                    // .....
+
+    // '(', 5 px
+    0x10,                    // ...#.
+    0x20,                    // ..#..
+    0x40,                    // .#...
+    0x40,                    // .#...
+    0x40,                    // .#...
+    0x20,                    // ..#..
+    0x10,                    // ...#.
+
+    // ')', 5 px
+    0x40,                    // .#...
+    0x20,                    // ..#..
+    0x10,                    // ...#.
+    0x10,                    // ...#.
+    0x10,                    // ...#.
+    0x20,                    // ..#..
+    0x40,                    // .#...
+
+    // '*', 5 px
+    0x00,                    // .....
+    0x50,                    // .#.#.
+    0x20,                    // ..#..
+    0xf8,                    // #####
+    0x20,                    // ..#..
+    0x50,                    // .#.#.
+    0x00,                    // .....
+
+    // '+', 5 px
+    0x00,                    // .....
+    0x20,                    // ..#..
+    0x20,                    // ..#..
+    0xf8,                    // #####
+    0x20,                    // ..#..
+    0x20,                    // ..#..
+    0x00,                    // .....
+
+    // ',', 5 px
+    0x00,                    // .....
+    0x00,                    // .....
+    0x00,                    // .....
+    0x00,                    // .....
+    0x60,                    // .##..
+    0x20,                    // ..#..
+    0x40,                    // .#...
+
+    // '-', 5 px
+    0x00,                    // .....
+    0x00,                    // .....
+    0x00,                    // .....
+    0xf8,                    // #####
+    0x00,                    // .....
+    0x00,                    // .....
+    0x00,                    // .....
+
+    // '.', 5 px
+    0x00,                    // .....
+    0x00,                    // .....
+    0x00,                    // .....
+    0x00,                    // .....
+    0x00,                    // .....
+    0x60,                    // .##..
+    0x60,                    // .##..
+
+    // '/', 5 px
+    0x00,                    // .....
+    0x08,                    // ....#
+    0x10,                    // ...#.
+    0x20,                    // ..#..
+    0x40,                    // .#...
+    0x80,                    // #....
+    0x00,                    // .....
+
+    // '0', 5 px
+    0x70,                    // .###.
+    0x88,                    // #...#
+    0x98,                    // #..##
+    0xa8,                    // #.#.#
+    0xc8,                    // ##..#
+    0x88,                    // #...#
+    0x70,                    // .###.
+
+    // '1', 5 px
+    0x20,                    // ..#..
+    0x60,                    // .##..
+    0x20,                    // ..#..
+    0x20,                    // ..#..
+    0x20,                    // ..#..
+    0x20,                    // ..#..
+    0x70,                    // .###.
+
+    // '2', 5 px
+    0x70,                    // .###.
+    0x88,                    // #...#
+    0x08,                    // ....#
+    0x10,                    // ...#.
+    0x20,                    // ..#..
+    0x40,                    // .#...
+    0xf8,                    // #####
+
+    // '3', 5 px
+    0xf8,                    // #####
+    0x10,                    // ...#.
+    0x20,                    // ..#..
+    0x10,                    // ...#.
+    0x08,                    // ....#
+    0x88,                    // #...#
+    0x70,                    // .###.
+
+    // '4', 5 px
+    0x10,                    // ...#.
+    0x30,                    // ..##.
+    0x50,                    // .#.#.
+    0x90,                    // #..#.
+    0xf8,                    // #####
+    0x10,                    // ...#.
+    0x10,                    // ...#.
+
+    // '5', 5 px
+    0xf8,                    // #####
+    0x80,                    // #....
+    0xf0,                    // ####.
+    0x08,                    // ....#
+    0x08,                    // ....#
+    0x88,                    // #...#
+    0x70,                    // .###.
+
+    // '6', 5 px
+    0x30,                    // ..##.
+    0x40,                    // .#...
+    0x80,                    // #....
+    0xf0,                    // ####.
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0x70,                    // .###.
+
+    // '7', 5 px
+    0xf8,                    // #####
+    0x08,                    // ....#
+    0x10,                    // ...#.
+    0x20,                    // ..#..
+    0x40,                    // .#...
+    0x40,                    // .#...
+    0x40,                    // .#...
+
+    // '8', 5 px
+    0x70,                    // .###.
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0x70,                    // .###.
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0x70,                    // .###.
+
+    // '9', 5 px
+    0x70,                    // .###.
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0x78,                    // .####
+    0x08,                    // ....#
+    0x10,                    // ...#.
+    0x60,                    // .##..
+
+    // ':', 5 px
+    0x00,                    // .....
+    0x60,                    // .##..
+    0x60,                    // .##..
+    0x00,                    // .....
+    0x60,                    // .##..
+    0x60,                    // .##..
+    0x00,                    // .....
+
+    // ';', 5 px
+    0x00,                    // .....
+    0x60,                    // .##..
+    0x60,                    // .##..
+    0x00,                    // .....
+    0x60,                    // .##..
+    0x20,                    // ..#..
+    0x40,                    // .#...
+
+    // '<', 5 px
+    0x08,                    // ....#
+    0x10,                    // ...#.
+    0x20,                    // ..#..
+    0x40,                    // .#...
+    0x20,                    // ..#..
+    0x10,                    // ...#.
+    0x08,                    // ....#
+
+    // '=', 5 px
+    0x00,                    // .....
+    0x00,                    // .....
+    0xf8,                    // #####
+    0x00,                    // .....
+    0xf8,                    // #####
+    0x00,                    // .....
+    0x00,                    // .....
+
+    // '>', 5 px
+    0x80,                    // #....
+    0x40,                    // .#...
+    0x20,                    // ..#..
+    0x10,                    // ...#.
+    0x20,                    // ..#..
+    0x40,                    // .#...
+    0x80,                    // #....
+
+    // '?', 5 px
+    0x70,                    // .###.
+    0x88,                    // #...#
+    0x08,                    // ....#
+    0x10,                    // ...#.
+    0x20,                    // ..#..
+    0x00,                    // .....
+    0x20,                    // ..#..
+
+    // '@', 5 px
+    0x70,                    // .###.
+    0x88,                    // #...#
+    0x08,                    // ....#
+    0x68,                    // .##.#
+    0xa8,                    // #.#.#
+    0xa8,                    // #.#.#
+    0x70,                    // .###.
+
+    // 'A', 5 px
+    0x70,                    // .###.
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0xf8,                    // #####
+    0x88,                    // #...#
+    0x88,                    // #...#
+
+    // 'B', 5 px
+    0xf0,                    // ####.
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0xf0,                    // ####.
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0xf0,                    // ####.
+
+    // 'C', 5 px
+    0x70,                    // .###.
+    0x88,                    // #...#
+    0x80,                    // #....
+    0x80,                    // #....
+    0x80,                    // #....
+    0x88,                    // #...#
+    0x70,                    // .###.
+
+    // 'D', 5 px
+    0xe0,                    // ###..
+    0x90,                    // #..#.
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0x90,                    // #..#.
+    0xe0,                    // ###..
+
+    // 'E', 5 px
+    0xf8,                    // #####
+    0x80,                    // #....
+    0x80,                    // #....
+    0xf0,                    // ####.
+    0x80,                    // #....
+    0x80,                    // #....
+    0xf8,                    // #####
+
+    // 'F', 5 px
+    0xf8,                    // #####
+    0x80,                    // #....
+    0x80,                    // #....
+    0xe0,                    // ###..
+    0x80,                    // #....
+    0x80,                    // #....
+    0x80,                    // #....
+
+    // 'G', 5 px
+    0x70,                    // .###.
+    0x88,                    // #...#
+    0x80,                    // #....
+    0x80,                    // #....
+    0x98,                    // #..##
+    0x88,                    // #...#
+    0x70,                    // .###.
+
+    // 'H', 5 px
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0xf8,                    // #####
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0x88,                    // #...#
+
+    // 'I', 5 px
+    0x70,                    // .###.
+    0x20,                    // ..#..
+    0x20,                    // ..#..
+    0x20,                    // ..#..
+    0x20,                    // ..#..
+    0x20,                    // ..#..
+    0x70,                    // .###.
+
+    // 'J', 5 px
+    0x38,                    // ..###
+    0x10,                    // ...#.
+    0x10,                    // ...#.
+    0x10,                    // ...#.
+    0x10,                    // ...#.
+    0x90,                    // #..#.
+    0x60,                    // .##..
+
+    // 'K', 5 px
+    0x88,                    // #...#
+    0x90,                    // #..#.
+    0xa0,                    // #.#..
+    0xc0,                    // ##...
+    0xa0,                    // #.#..
+    0x90,                    // #..#.
+    0x88,                    // #...#
+
+    // 'L', 5 px
+    0x80,                    // #....
+    0x80,                    // #....
+    0x80,                    // #....
+    0x80,                    // #....
+    0x80,                    // #....
+    0x80,                    // #....
+    0xf8,                    // #####
+
+    // 'M', 5 px
+    0x88,                    // #...#
+    0xd8,                    // ##.##
+    0xa8,                    // #.#.#
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0x88,                    // #...#
+
+    // 'N', 5 px
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0xc8,                    // ##..#
+    0xa8,                    // #.#.#
+    0x98,                    // #..##
+    0x88,                    // #...#
+    0x88,                    // #...#
+
+    // 'O', 5 px
+    0x70,                    // .###.
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0x70,                    // .###.
+
+    // 'P', 5 px
+    0xf0,                    // ####.
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0xf0,                    // ####.
+    0x80,                    // #....
+    0x80,                    // #....
+    0x80,                    // #....
+
+    // 'Q', 5 px
+    0x70,                    // .###.
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0xa8,                    // #.#.#
+    0x90,                    // #..#.
+    0x68,                    // .##.#
+
+    // 'R', 5 px
+    0xf0,                    // ####.
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0xf0,                    // ####.
+    0xa0,                    // #.#..
+    0x90,                    // #..#.
+    0x88,                    // #...#
+
+    // 'S', 5 px
+    0x78,                    // .####
+    0x80,                    // #....
+    0x80,                    // #....
+    0x70,                    // .###.
+    0x08,                    // ....#
+    0x08,                    // ....#
+    0xf0,                    // ####.
+
+    // 'T', 5 px
+    0xf8,                    // #####
+    0x20,                    // ..#..
+    0x20,                    // ..#..
+    0x20,                    // ..#..
+    0x20,                    // ..#..
+    0x20,                    // ..#..
+    0x20,                    // ..#..
+
+    // 'U', 5 px
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0x70,                    // .###.
+
+    // 'V', 5 px
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0x50,                    // .#.#.
+    0x20,                    // ..#..
+
+    // 'W', 5 px
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0xa8,                    // #.#.#
+    0xa8,                    // #.#.#
+    0xd8,                    // ##.##
+    0x88,                    // #...#
+
+    // 'X', 5 px
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0x50,                    // .#.#.
+    0x20,                    // ..#..
+    0x50,                    // .#.#.
+    0x88,                    // #...#
+    0x88,                    // #...#
+
+    // 'Y', 5 px
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0x50,                    // .#.#.
+    0x20,                    // ..#..
+    0x20,                    // ..#..
+    0x20,                    // ..#..
+    0x20,                    // ..#..
+
+    // 'Z', 5 px
+    0xf8,                    // #####
+    0x08,                    // ....#
+    0x10,                    // ...#.
+    0x20,                    // ..#..
+    0x40,                    // .#...
+    0x80,                    // #....
+    0xf8,                    // #####
+
+    // '[', 5 px
+    0x38,                    // ..###
+    0x20,                    // ..#..
+    0x20,                    // ..#..
+    0x20,                    // ..#..
+    0x20,                    // ..#..
+    0x20,                    // ..#..
+    0x38,                    // ..###
+
+    // '\\', 5 px
+    0x00,                    // .....
+    0x80,                    // #....
+    0x40,                    // .#...
+    0x20,                    // ..#..
+    0x10,                    // ...#.
+    0x08,                    // ....#
+    0x00,                    // .....
+
+    // ']', 5 px
+    0xe0,                    // ###..
+    0x20,                    // ..#..
+    0x20,                    // ..#..
+    0x20,                    // ..#..
+    0x20,                    // ..#..
+    0x20,                    // ..#..
+    0xe0,                    // ###..
+
+    // '^', 5 px
+    0x20,                    // ..#..
+    0x50,                    // .#.#.
+    0x88,                    // #...#
+    0x00,                    // .....
+    0x00,                    // .....
+    0x00,                    // .....
+    0x00,                    // .....
+
+    // '_', 5 px
+    0x00,                    // .....
+    0x00,                    // .....
+    0x00,                    // .....
+    0x00,                    // .....
+    0x00,                    // .....
+    0x00,                    // .....
+    0xf8,                    // #####
+
+    // '`', 5 px
+    0x40,                    // .#...
+    0x20,                    // ..#..
+    0x10,                    // ...#.
+    0x00,                    // .....
+    0x00,                    // .....
+    0x00,                    // .....
+    0x00,                    // .....
+
+    // 'a', 5 px
+    0x00,                    // .....
+    0x00,                    // .....
+    0x70,                    // .###.
+    0x08,                    // ....#
+    0x78,                    // .####
+    0x88,                    // #...#
+    0x78,                    // .####
+
+    // 'b', 5 px
+    0x80,                    // #....
+    0x80,                    // #....
+    0xb0,                    // #.##.
+    0xc8,                    // ##..#
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0xf0,                    // ####.
+
+    // 'c', 5 px
+    0x00,                    // .....
+    0x00,                    // .....
+    0x70,                    // .###.
+    0x80,                    // #....
+    0x80,                    // #....
+    0x88,                    // #...#
+    0x70,                    // .###.
+
+    // 'd', 5 px
+    0x08,                    // ....#
+    0x08,                    // ....#
+    0x68,                    // .##.#
+    0x98,                    // #..##
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0x78,                    // .####
+
+    // 'e', 5 px
+    0x00,                    // .....
+    0x00,                    // .....
+    0x70,                    // .###.
+    0x88,                    // #...#
+    0xf8,                    // #####
+    0x80,                    // #....
+    0x70,                    // .###.
+
+    // 'f', 5 px
+    0x30,                    // ..##.
+    0x48,                    // .#..#
+    0x40,                    // .#...
+    0xe0,                    // ###..
+    0x40,                    // .#...
+    0x40,                    // .#...
+    0x40,                    // .#...
+
+    // 'g', 5 px
+    0x00,                    // .....
+    0x00,                    // .....
+    0x78,                    // .####
+    0x88,                    // #...#
+    0x78,                    // .####
+    0x08,                    // ....#
+    0x30,                    // ..##.
+
+    // 'h', 5 px
+    0x80,                    // #....
+    0x80,                    // #....
+    0xb0,                    // #.##.
+    0xc8,                    // ##..#
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0x88,                    // #...#
+
+    // 'i', 5 px
+    0x20,                    // ..#..
+    0x00,                    // .....
+    0x60,                    // .##..
+    0x20,                    // ..#..
+    0x20,                    // ..#..
+    0x20,                    // ..#..
+    0x70,                    // .###.
+
+    // 'j', 5 px
+    0x10,                    // ...#.
+    0x00,                    // .....
+    0x30,                    // ..##.
+    0x10,                    // ...#.
+    0x10,                    // ...#.
+    0x90,                    // #..#.
+    0x60,                    // .##..
+
+    // 'k', 5 px
+    0x40,                    // .#...
+    0x40,                    // .#...
+    0x48,                    // .#..#
+    0x50,                    // .#.#.
+    0x60,                    // .##..
+    0x50,                    // .#.#.
+    0x48,                    // .#..#
+
+    // 'l', 5 px
+    0x60,                    // .##..
+    0x20,                    // ..#..
+    0x20,                    // ..#..
+    0x20,                    // ..#..
+    0x20,                    // ..#..
+    0x20,                    // ..#..
+    0x70,                    // .###.
+
+    // 'm', 5 px
+    0x00,                    // .....
+    0x00,                    // .....
+    0xd0,                    // ##.#.
+    0xa8,                    // #.#.#
+    0xa8,                    // #.#.#
+    0x88,                    // #...#
+    0x88,                    // #...#
+
+    // 'n', 5 px
+    0x00,                    // .....
+    0x00,                    // .....
+    0xb0,                    // #.##.
+    0xc8,                    // ##..#
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0x88,                    // #...#
+
+    // 'o', 5 px
+    0x00,                    // .....
+    0x00,                    // .....
+    0x70,                    // .###.
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0x70,                    // .###.
+
+    // 'p', 5 px
+    0x00,                    // .....
+    0x00,                    // .....
+    0xf0,                    // ####.
+    0x88,                    // #...#
+    0xf0,                    // ####.
+    0x80,                    // #....
+    0x80,                    // #....
+
+    // 'q', 5 px
+    0x00,                    // .....
+    0x00,                    // .....
+    0x68,                    // .##.#
+    0x98,                    // #..##
+    0x78,                    // .####
+    0x08,                    // ....#
+    0x08,                    // ....#
+
+    // 'r', 5 px
+    0x00,                    // .....
+    0x00,                    // .....
+    0xb0,                    // #.##.
+    0xc8,                    // ##..#
+    0x80,                    // #....
+    0x80,                    // #....
+    0x80,                    // #....
+
+    // 's', 5 px
+    0x00,                    // .....
+    0x00,                    // .....
+    0x70,                    // .###.
+    0x80,                    // #....
+    0x70,                    // .###.
+    0x08,                    // ....#
+    0xf0,                    // ####.
+
+    // 't', 5 px
+    0x40,                    // .#...
+    0x40,                    // .#...
+    0xe0,                    // ###..
+    0x40,                    // .#...
+    0x40,                    // .#...
+    0x48,                    // .#..#
+    0x30,                    // ..##.
+
+    // 'u', 5 px
+    0x00,                    // .....
+    0x00,                    // .....
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0x98,                    // #..##
+    0x68,                    // .##.#
+
+    // 'v', 5 px
+    0x00,                    // .....
+    0x00,                    // .....
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0x50,                    // .#.#.
+    0x20,                    // ..#..
+
+    // 'w', 5 px
+    0x00,                    // .....
+    0x00,                    // .....
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0xa8,                    // #.#.#
+    0xa8,                    // #.#.#
+    0x50,                    // .#.#.
+
+    // 'x', 5 px
+    0x00,                    // .....
+    0x00,                    // .....
+    0x88,                    // #...#
+    0x50,                    // .#.#.
+    0x20,                    // ..#..
+    0x50,                    // .#.#.
+    0x88,                    // #...#
+
+    // 'y', 5 px
+    0x00,                    // .....
+    0x00,                    // .....
+    0x88,                    // #...#
+    0x88,                    // #...#
+    0x78,                    // .####
+    0x08,                    // ....#
+    0x70,                    // .###.
+
+    // 'z', 5 px
+    0x00,                    // .....
+    0x00,                    // .....
+    0xf8,                    // #####
+    0x10,                    // ...#.
+    0x20,                    // ..#..
+    0x40,                    // .#...
+    0xf8,                    // #####
+
+    // '{', 5 px
+    0x10,                    // ...#.
+    0x20,                    // ..#..
+    0x20,                    // ..#..
+    0x40,                    // .#...
+    0x20,                    // ..#..
+    0x20,                    // ..#..
+    0x10,                    // ...#.
+
+    // '|', 5 px
+    0x20,                    // ..#..
+    0x20,                    // ..#..
+    0x20,                    // ..#..
+    0x20,                    // ..#..
+    0x20,                    // ..#..
+    0x20,                    // ..#..
+    0x20,                    // ..#..
+
+    // '}', 5 px
+    0x40,                    // .#...
+    0x20,                    // ..#..
+    0x20,                    // ..#..
+    0x10,                    // ...#.
+    0x20,                    // ..#..
+    0x20,                    // ..#..
+    0x40,                    // .#...
+
+    // '~', 5 px
+    0x00,                    // .....
+    0x20,                    // ..#..
+    0x10,                    // ...#.
+    0xf8,                    // #####
+    0x10,                    // ...#.
+    0x20,                    // ..#..
+    0x00,                    // .....
+};
+
+#endif // FONT5X7_ROWS_H
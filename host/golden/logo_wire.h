@@ -0,0 +1,45 @@
+/*
+ * logo_wire.h - golden_logo_wire, 32x16 pixels
+ *
+ * Generated by tools/bitmap_compile.py from fesb_logo.pbm, do not edit.
+ * Format WIRE, 68 bytes of flash (4 of them header). Draw it with
+ *   vma419_draw_bitmap_P(&display, x, y, golden_logo_wire);
+ *
+ *   ................................
+ *   ................................
+ *   ...######.######.############...
+ *   ..######.#####################..
+ *   .####....###....####..#....###..
+ *   .###.....##.....###.........###.
+ *   .##......#......###........###..
+ *   .#.######.############.#######..
+ *   ..######.#######.######.######..
+ *   .####....###........###....###..
+ *   .###.....##..........##.....###.
+ *   .###.....###..#....####....###..
+ *   .###.....##############.######..
+ *   .###......############.######...
+ *   ................................
+ *   ................................
+ */
+
+#ifndef LOGO_WIRE_H
+#define LOGO_WIRE_H
+
+#include <stdint.h>
+#include <avr/pgmspace.h>
+
+#define GOLDEN_LOGO_WIRE_WIDTH  32
+#define GOLDEN_LOGO_WIRE_HEIGHT 16
+
+const uint8_t golden_logo_wire[] PROGMEM = {
+    1, 32, 0, 16,  // WIRE, width 32, height 16
+    0x70, 0x78, 0x3f, 0x70, 0x70, 0x00, 0x60, 0x00, 0xfd, 0x0e, 0xf8, 0x1c,
+    0xe0, 0x00, 0x0e, 0x00, 0x00, 0x70, 0x00, 0x60, 0x60, 0x1f, 0x40, 0xbf,
+    0x00, 0x06, 0x00, 0x0e, 0xe0, 0x7f, 0x1c, 0xf8, 0x00, 0x70, 0x00, 0x72,
+    0x5f, 0x3f, 0xbf, 0x7f, 0x00, 0x1e, 0x00, 0x1c, 0xfd, 0xff, 0xfc, 0xfc,
+    0x70, 0x3f, 0x7f, 0x7f, 0x78, 0x00, 0x70, 0x00, 0xfe, 0x7e, 0xfc, 0xfc,
+    0xf2, 0x00, 0x1c, 0x00,
+};
+
+#endif // LOGO_WIRE_H
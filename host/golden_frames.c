@@ -0,0 +1,615 @@
+/*
+ * golden_frames.c - Golden-Frame Check for the Rendering Code (host build)
+ *
+ * Renders a fixed list of strings, positions, character sets, the logo and
+ * flash bitmaps into a VMA419 frame buffer with the real driver code
+ * (vma419.c, VMA419_Font.h, fesb_logo.h, utf8_latin1.h) and checks the result two ways:
+ * 1. Byte for byte against the frames stored in golden/frames.txt
+ * 2. Against a deliberately simple reference renderer in this file, which
+ *    works out the frame buffer layout and row remap from scratch
+ *
+ * (1) catches any change in output, (2) tells whether the stored frames
+ * themselves are right. The lit LED counts the driver keeps per scan phase
+ * (for the OE timing) are also checked against a recount of the frame. Run it before and after touching any drawing code.
+ *
+ * Usage:
+ *   ./golden_frames              check everything, exit code 1 on any mismatch
+ *   ./golden_frames --update     rewrite golden/frames.txt from the current code
+ *   ./golden_frames --show NAME  print one case as ASCII art
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "vma419.h"
+#include "VMA419_Font.h"
+#include "fesb_logo.h"
+#include "VMA419_FontCreator.h"
+#include "Cpp_Lib/DMD419/Arial14.h"
+#include "Cpp_Lib/DMD419/Arial_black_16.h"
+#include "Cpp_Lib/DMD419/SystemFont5x7.h"
+#include "Cpp_Lib/DMD419/Arial_Black_16_ISO_8859_1.h"
+#include "utf8_latin1.h"
+#include "golden/arrow_raw.h"       // tools/bitmap_compile.py output for
+#include "golden/arrow_rle.h"       // golden/arrow.pbm and image/fesb_logo.pbm
+#include "golden/logo_wire.h"
+#include "golden/font5x7_rows.h"    // tools/font_compile.py output for VMA419_Font.h
+
+#define GOLDEN_FILE     "golden/frames.txt"
+#define MAX_PANELS_WIDE 2
+#define MAX_FRAME_BYTES (MAX_PANELS_WIDE * VMA419_RAM_SIZE_BYTES)
+
+//==============================================================================
+// TEST CORPUS
+//==============================================================================
+
+typedef enum {
+    CASE_TEXT,          // vma419_font_draw_string(text, x, y)
+    CASE_CENTERED,      // vma419_font_draw_string_centered(y, text)
+    CASE_NUMBER,        // vma419_font_draw_number_2d(x, y, number in text)
+    CASE_CHARSET,       // 10 characters from x on, in two lines of 5
+    CASE_LOGO,          // fesb_logo_display()
+    CASE_DIAGONALS,     // vma419_set_pixel() on both diagonals of every panel
+    CASE_MODES,         // logo, then every vma419_write_pixel() mode over it
+    CASE_BITMAP,        // WIRE logo, then the "raw"/"rle" arrow at x, y ("wire": logo only)
+    CASE_ROWTEXT,       // vma419_draw_text_P(text, x, y) with VMA419_Font.h as a row font
+    CASE_ARIAL14,       // vma419_fc_draw_string(text, x, y) with a FontCreator font:
+    CASE_ARIAL_BK,   // Arial_14, Arial_Black_16 or System5x7
+    CASE_SYSTEM5X7,
+    CASE_LATIN1         // UTF-8 text through utf8_to_latin1(), then Arial_Black_16_ISO_8859_1
+} CaseKind;
+
+typedef struct {
+    const char* name;
+    CaseKind kind;
+    uint8_t panels_wide;
+    const char* text;
+    int16_t x;
+    int16_t y;
+} GoldenCase;
+
+static const GoldenCase cases[] = {
+    { "welcome_right_edge", CASE_TEXT,      1, "WELCOME ERASMUS STUDENTS ", 32,   4 },
+    { "welcome_start",      CASE_TEXT,      1, "WELCOME ERASMUS STUDENTS ", 0,    4 },
+    { "welcome_minus1",     CASE_TEXT,      1, "WELCOME ERASMUS STUDENTS ", -1,   4 },
+    { "welcome_minus37",    CASE_TEXT,      1, "WELCOME ERASMUS STUDENTS ", -37,  4 },
+    { "welcome_tail",       CASE_TEXT,      1, "WELCOME ERASMUS STUDENTS ", -140, 4 },
+    { "hello_top",          CASE_TEXT,      1, "Hello", 0,  0 },
+    { "hello_y9",           CASE_TEXT,      1, "Hello", 0,  9 },
+    { "hello_clip_top",     CASE_TEXT,      1, "Hello", 0,  -3 },
+    { "hello_clip_bottom",  CASE_TEXT,      1, "Hello", 3,  12 },
+    { "hello_clip_left",    CASE_TEXT,      1, "Hello", -2, 4 },
+    { "hello_y15",          CASE_TEXT,      1, "Hello", 1,  15 },
+    { "centered_hi",        CASE_CENTERED,  1, "HI", 0, 4 },
+    { "centered_fesb",      CASE_CENTERED,  1, "FESB", 0, 8 },
+    { "number_07",          CASE_NUMBER,    1, "7",  2, 0 },
+    { "number_42",          CASE_NUMBER,    1, "42", 10, 5 },
+    { "number_99",          CASE_NUMBER,    1, "99", 20, 9 },
+    { "charset_32",         CASE_CHARSET,   1, " !\"#$%&'()", 1, 0 },
+    { "charset_42",         CASE_CHARSET,   1, "*+,-./0123", 1, 0 },
+    { "charset_52",         CASE_CHARSET,   1, "456789:;<=", 1, 0 },
+    { "charset_62",         CASE_CHARSET,   1, ">?@ABCDEFG", 1, 0 },
+    { "charset_72",         CASE_CHARSET,   1, "HIJKLMNOPQ", 1, 0 },
+    { "charset_82",         CASE_CHARSET,   1, "RSTUVWXYZ[", 1, 0 },
+    { "charset_92",         CASE_CHARSET,   1, "\\]^_`abcde", 1, 0 },
+    { "charset_102",        CASE_CHARSET,   1, "fghijklmno", 1, 0 },
+    { "charset_112",        CASE_CHARSET,   1, "pqrstuvwxy", 1, 0 },
+    { "charset_122",        CASE_CHARSET,   1, "z{|}~",      1, 0 },
+    { "logo",               CASE_LOGO,      1, NULL, 0, 0 },
+    { "diagonals_1x1",      CASE_DIAGONALS, 1, NULL, 0, 0 },
+    { "diagonals_2x1",      CASE_DIAGONALS, 2, NULL, 0, 0 },
+    { "modes",              CASE_MODES,     1, NULL, 0, 0 },
+    { "bitmap_wire",        CASE_BITMAP,    1, "wire", 0, 0 },
+    { "bitmap_raw_aligned", CASE_BITMAP,    1, "raw", 8,  2 },
+    { "bitmap_raw_shifted", CASE_BITMAP,    1, "raw", 5,  3 },
+    { "bitmap_rle_shifted", CASE_BITMAP,    1, "rle", 3,  1 },
+    { "bitmap_rle_clip_tl", CASE_BITMAP,    1, "rle", -6, -4 },
+    { "bitmap_rle_clip_br", CASE_BITMAP,    1, "rle", 17, 9 },
+    { "bitmap_raw_2x1",     CASE_BITMAP,    2, "raw", 22, 2 },
+    { "rowfont_start",      CASE_ROWTEXT,   1, "WELCOME ERASMUS STUDENTS ", 0,   4 },
+    { "rowfont_minus37",    CASE_ROWTEXT,   1, "WELCOME ERASMUS STUDENTS ", -37, 4 },
+    { "rowfont_clip_top",   CASE_ROWTEXT,   1, "Hello", -2, -3 },
+    { "rowfont_clip_bot",   CASE_ROWTEXT,   1, "{|}~@", 3,  12 },
+    { "rowfont_2x1",        CASE_ROWTEXT,   2, "jpgq 0123456789", 1, 9 },
+    { "arial14_welcome",    CASE_ARIAL14,   1, "WELCOME ERASMUS", -5, 1 },
+    { "arial14_jgpq",       CASE_ARIAL14,   1, "jgpq@Wi", 0, 2 },
+    { "arial14_clip",       CASE_ARIAL14,   2, "Tag {}|~", 30, -3 },
+    { "arial_black_split",  CASE_ARIAL_BK,  1, "Hi!", 2, 0 },
+    { "arial_black_2x1",    CASE_ARIAL_BK,  2, "FESB 42", -4, 3 },
+    { "system5x7_text",     CASE_SYSTEM5X7, 1, "Hello", 0, 4 },
+    { "system5x7_clip",     CASE_SYSTEM5X7, 1, "x=~7}", -3, 12 },
+    { "latin1_accents",     CASE_LATIN1,    1, "\xc3\x88\xc3\xa9\xc3\xb6\xc3\x9f", 0, 0 },
+    { "latin1_2x1",         CASE_LATIN1,    2, "Z\xc3\xbcrich \xc2\xa9\xc2\xbd", -3, 0 },
+};
+
+#define CASE_COUNT (sizeof(cases) / sizeof(cases[0]))
+
+//==============================================================================
+// REAL DRIVER
+//==============================================================================
+
+static VMA419_PinConfig host_pins = {
+    .a_port_ddr         = &DDRA, .a_port_out         = &PORTA, .a_pin_mask         = (1 << PA1),
+    .b_port_ddr         = &DDRA, .b_port_out         = &PORTA, .b_pin_mask         = (1 << PA2),
+    .latch_clk_port_ddr = &DDRA, .latch_clk_port_out = &PORTA, .latch_clk_pin_mask = (1 << PA4),
+    .oe_port_ddr        = &DDRD, .oe_port_out        = &PORTD, .oe_pin_mask        = (1 << PD7)
+};
+
+static const uint8_t* golden_fc_font(CaseKind kind) {
+    return (kind == CASE_ARIAL14) ? Arial_14 : (kind == CASE_ARIAL_BK) ? Arial_Black_16 : System5x7;
+}
+
+// Render one case with the real code, returns the frame buffer size
+static uint16_t render_driver(const GoldenCase* c, uint8_t* frame, uint16_t* phase_lit) {
+    VMA419_Display disp;
+
+    host_reset();
+    if (vma419_init(&disp, &host_pins, c->panels_wide, 1) != 0) {
+        fprintf(stderr, "vma419_init failed\n");
+        exit(2);
+    }
+    vma419_font_init(&disp);
+
+    switch (c->kind) {
+        case CASE_TEXT:
+            vma419_font_draw_string(&disp, c->x, c->y, c->text);
+            break;
+        case CASE_CENTERED:
+            vma419_font_draw_string_centered(&disp, c->y, c->text);
+            break;
+        case CASE_NUMBER:
+            vma419_font_draw_number_2d(&disp, c->x, c->y, (uint8_t)atoi(c->text));
+            break;
+        case CASE_CHARSET:
+            for (uint8_t i = 0; c->text[i]; i++) {
+                vma419_font_draw_char(&disp, c->x + (i % 5) * 6, c->y + (i / 5) * 8, c->text[i]);
+            }
+            break;
+        case CASE_LOGO:
+            fesb_logo_display(&disp);
+            break;
+        case CASE_DIAGONALS:
+            for (uint16_t x = 0; x < disp.total_width_pixels; x++) {
+                uint16_t y = x % 16;
+                vma419_set_pixel(&disp, x, ((x / 16) & 1) ? 15 - y : y, 1);
+            }
+            break;
+        case CASE_MODES:
+            fesb_logo_display(&disp);
+            for (uint16_t y = 4; y < 12; y++) {
+                for (uint16_t x = 8; x < 24; x++) {
+                    vma419_write_pixel(&disp, x, y, VMA419_GRAPHICS_TOGGLE, 1);
+                }
+            }
+            for (uint16_t x = 0; x < 32; x++) {
+                vma419_write_pixel(&disp, x, 0, VMA419_GRAPHICS_NOR, 1);
+                vma419_write_pixel(&disp, x, 1, VMA419_GRAPHICS_INVERSE, x & 1);
+                vma419_write_pixel(&disp, x, 2, VMA419_GRAPHICS_NORMAL, (x >> 1) & 1);
+            }
+            for (uint16_t y = 0; y < 16; y++) {
+                vma419_write_pixel(&disp, 31, y, VMA419_GRAPHICS_OR, 1);
+                vma419_write_pixel(&disp, 0, y, VMA419_GRAPHICS_OR, 0);
+            }
+            break;
+        case CASE_BITMAP: {
+            const uint8_t* arrow = (strcmp(c->text, "rle") == 0) ? golden_arrow_rle : golden_arrow_raw;
+            int status = (c->panels_wide == 1) ? vma419_draw_bitmap_P(&disp, 0, 0, golden_logo_wire) : 0;
+            if (strcmp(c->text, "wire") != 0) status |= vma419_draw_bitmap_P(&disp, c->x, c->y, arrow);
+            if (status != 0) {
+                fprintf(stderr, "vma419_draw_bitmap_P failed for %s\n", c->name);
+                exit(2);
+            }
+            break;
+        }
+        case CASE_ROWTEXT:
+            vma419_draw_text_P(&disp, c->x, c->y, golden_font5x7_rows, c->text);
+            break;
+        case CASE_ARIAL14:
+        case CASE_ARIAL_BK:
+        case CASE_SYSTEM5X7: {
+            VMA419_FCFont font;
+            vma419_fc_select(&font, golden_fc_font(c->kind));
+            vma419_fc_draw_string(&disp, &font, c->x, c->y, c->text);
+            break;
+        }
+        case CASE_LATIN1: {
+            VMA419_FCFont font;
+            char text[32];
+            utf8_to_latin1(text, c->text, sizeof(text));
+            vma419_fc_select(&font, Arial_Black_16_ISO_8859_1);
+            vma419_fc_draw_string(&disp, &font, c->x, c->y, text);
+            break;
+        }
+    }
+
+    memcpy(frame, disp.frame_buffer, disp.frame_buffer_size);
+    memcpy(phase_lit, disp.phase_lit, sizeof(disp.phase_lit));
+    uint16_t size = disp.frame_buffer_size;
+    vma419_deinit(&disp);
+    return size;
+}
+
+//==============================================================================
+// REFERENCE RENDERER
+//==============================================================================
+// Written from the panel description, not from vma419.c:
+// - The frame buffer is 16 RAM rows; a RAM row holds 4 bytes per panel,
+//   panel 0 first, and inside a byte the MSB is the leftmost pixel
+// - Picture row y is stored in RAM row 4*(y/4) + {3, 0, 1, 2}[y%4]
+
+static const uint8_t ref_row_map[4] = { 3, 0, 1, 2 };
+
+static uint8_t* ref_byte(uint8_t* frame, uint8_t panels_wide, int x, int y, uint8_t* mask) {
+    int ram_row = (y & ~3) + ref_row_map[y & 3];
+    *mask = (uint8_t)(0x80 >> (x % 8));
+    return &frame[ram_row * panels_wide * 4 + x / 8];
+}
+
+static int ref_get(uint8_t* frame, uint8_t panels_wide, int x, int y) {
+    uint8_t mask;
+    return (*ref_byte(frame, panels_wide, x, y, &mask) & mask) != 0;
+}
+
+static void ref_plot(uint8_t* frame, uint8_t panels_wide, int x, int y, uint8_t mode, int pixel) {
+    uint8_t mask;
+    if (x < 0 || y < 0 || x >= panels_wide * 32 || y >= 16) return;
+    uint8_t* b = ref_byte(frame, panels_wide, x, y, &mask);
+
+    int on = (*b & mask) != 0;
+    switch (mode) {
+        case VMA419_GRAPHICS_NORMAL:  on = pixel;           break;
+        case VMA419_GRAPHICS_INVERSE: on = !pixel;          break;
+        case VMA419_GRAPHICS_TOGGLE:  if (pixel) on = !on;  break;
+        case VMA419_GRAPHICS_OR:      if (pixel) on = 1;    break;
+        case VMA419_GRAPHICS_NOR:     if (pixel) on = 0;    break;
+    }
+    if (on) *b |= mask; else *b &= ~mask;
+}
+
+// One 5x7 character, only "on" bits are drawn, returns the cursor advance
+static int ref_char(uint8_t* frame, uint8_t panels_wide, int x, int y, char c) {
+    if (c < 32 || c > 126) return 1;
+    for (int col = 0; col < 5; col++) {
+        uint8_t bits = vma419_font_5x7[(c - 32) * 5 + col];
+        for (int row = 0; row < 7; row++) {
+            if (bits & (1 << row)) ref_plot(frame, panels_wide, x + col, y + row, VMA419_GRAPHICS_OR, 1);
+        }
+    }
+    return 6;
+}
+
+static void ref_string(uint8_t* frame, uint8_t panels_wide, int x, int y, const char* s) {
+    while (*s && x < 32) {
+        x += ref_char(frame, panels_wide, x, y, *s++);
+    }
+}
+
+// The pictures the flash bitmaps must give (image/fesb_logo.pbm, golden/arrow.pbm)
+static const char* const ref_logo_picture[16] = {
+    "................................",
+    "................................",
+    "...######.######.############...",
+    "..######.#####################..",
+    ".####....###....####..#....###..",
+    ".###.....##.....###.........###.",
+    ".##......#......###........###..",
+    ".#.######.############.#######..",
+    "..######.#######.######.######..",
+    ".####....###........###....###..",
+    ".###.....##..........##.....###.",
+    ".###.....###..#....####....###..",
+    ".###.....##############.######..",
+    ".###......############.######...",
+    "................................",
+    "................................",
+};
+
+static const char* const ref_arrow_picture[12] = {
+    ".....................",
+    ".....................",
+    "..............#......",
+    "..............###....",
+    "#####################",
+    "#####################",
+    "#####################",
+    "..............###....",
+    "..............#......",
+    ".....................",
+    "#.#.#.#.#.#.#.#.#.#.#",
+    ".....................",
+};
+
+// Every pixel of the picture is drawn, on or off
+static void ref_picture(uint8_t* frame, uint8_t panels_wide, int x, int y, const char* const* picture, int height) {
+    for (int row = 0; row < height; row++) {
+        for (int col = 0; picture[row][col]; col++) {
+            ref_plot(frame, panels_wide, x + col, y + row, VMA419_GRAPHICS_NORMAL, picture[row][col] == '#');
+        }
+    }
+}
+
+// FontCreator text: size (0 = fixed width), width, height, first, count,
+// widths, then per glyph (height+7)/8 rows of column bytes, bit 0 at the
+// top, the last row of bytes ending at the bottom of the glyph
+static void ref_fc_string(uint8_t* frame, uint8_t panels_wide, int x, int y, const uint8_t* font, const char* s) {
+    int fixed = (font[0] == 0 && font[1] == 0);
+    int height = font[3], first = font[4], count = font[5];
+    int bytes = (height + 7) / 8;
+
+    for (; *s && x < panels_wide * 32; s++) {
+        int c = (unsigned char)*s;
+        int look = (c == ' ') ? 'n' : c;    // Space takes the width of 'n'
+        if (look < first || look >= first + count) continue;
+
+        int width = fixed ? font[2] : font[6 + look - first];
+        const uint8_t* glyph = font + 6 + (fixed ? 0 : count);
+        for (int g = first; g < c; g++) glyph += (fixed ? font[2] : font[6 + g - first]) * bytes;
+
+        if (c != ' ') {
+            for (int col = 0; col < width; col++) {
+                for (int row = 0; row < height; row++) {
+                    int b = row / 8, bit = row % 8;
+                    if (bytes > 1 && row >= height - 8 && b >= bytes - 1) {
+                        b = bytes - 1;
+                        bit = row - (height - 8);
+                    }
+                    if ((glyph[b * width + col] >> bit) & 1) ref_plot(frame, panels_wide, x + col, y + row, VMA419_GRAPHICS_OR, 1);
+                }
+            }
+        }
+        if (width) x += width + 1;
+    }
+}
+
+static void ref_logo(uint8_t* frame) {
+    ref_picture(frame, 1, 0, 0, ref_logo_picture, 16);
+}
+
+static uint16_t render_reference(const GoldenCase* c, uint8_t* frame) {
+    uint8_t pw = c->panels_wide;
+    uint16_t size = pw * VMA419_RAM_SIZE_BYTES;
+    memset(frame, 0, size);
+
+    switch (c->kind) {
+        case CASE_TEXT:
+            ref_string(frame, pw, c->x, c->y, c->text);
+            break;
+        case CASE_CENTERED: {
+            int len = (int)strlen(c->text);
+            int start = (32 - (len * 6 - 1)) / 2;
+            ref_string(frame, pw, start < 0 ? 0 : start, c->y, c->text);
+            break;
+        }
+        case CASE_NUMBER: {
+            int n = atoi(c->text);
+            ref_char(frame, pw, c->x, c->y, '0' + n / 10);
+            ref_char(frame, pw, c->x + 6, c->y, '0' + n % 10);
+            break;
+        }
+        case CASE_CHARSET:
+            for (int i = 0; c->text[i]; i++) {
+                ref_char(frame, pw, c->x + (i % 5) * 6, c->y + (i / 5) * 8, c->text[i]);
+            }
+            break;
+        case CASE_LOGO:
+            ref_logo(frame);
+            break;
+        case CASE_DIAGONALS:
+            for (int x = 0; x < pw * 32; x++) {
+                ref_plot(frame, pw, x, ((x / 16) & 1) ? 15 - x % 16 : x % 16, VMA419_GRAPHICS_NORMAL, 1);
+            }
+            break;
+        case CASE_MODES:
+            ref_logo(frame);
+            for (int y = 4; y < 12; y++) {
+                for (int x = 8; x < 24; x++) ref_plot(frame, pw, x, y, VMA419_GRAPHICS_TOGGLE, 1);
+            }
+            for (int x = 0; x < 32; x++) {
+                ref_plot(frame, pw, x, 0, VMA419_GRAPHICS_NOR, 1);
+                ref_plot(frame, pw, x, 1, VMA419_GRAPHICS_INVERSE, x & 1);
+                ref_plot(frame, pw, x, 2, VMA419_GRAPHICS_NORMAL, (x >> 1) & 1);
+            }
+            for (int y = 0; y < 16; y++) {
+                ref_plot(frame, pw, 31, y, VMA419_GRAPHICS_OR, 1);
+                ref_plot(frame, pw, 0, y, VMA419_GRAPHICS_OR, 0);
+            }
+            break;
+        case CASE_BITMAP:
+            if (pw == 1) ref_logo(frame);
+            if (strcmp(c->text, "wire") != 0) ref_picture(frame, pw, c->x, c->y, ref_arrow_picture, 12);
+            break;
+        case CASE_ROWTEXT:
+            for (int i = 0, x = c->x; c->text[i] && x < pw * 32; i++) {
+                x += ref_char(frame, pw, x, c->y, c->text[i]);
+            }
+            break;
+        case CASE_ARIAL14:
+        case CASE_ARIAL_BK:
+        case CASE_SYSTEM5X7:
+            ref_fc_string(frame, pw, c->x, c->y, golden_fc_font(c->kind), c->text);
+            break;
+        case CASE_LATIN1: {
+            // The cases only use U+0000..U+00FF: ASCII, or two bytes 110000xx 10xxxxxx
+            char text[32];
+            int n = 0;
+            for (const uint8_t* s = (const uint8_t*)c->text; *s && n < 31; n++) {
+                if (*s < 0x80) {
+                    text[n] = (char)*s++;
+                } else {
+                    text[n] = (char)(((s[0] & 0x03) << 6) | (s[1] & 0x3F));
+                    s += 2;
+                }
+            }
+            text[n] = '\0';
+            ref_fc_string(frame, pw, c->x, c->y, Arial_Black_16_ISO_8859_1, text);
+            break;
+        }
+    }
+    return size;
+}
+
+//==============================================================================
+// GOLDEN FILE
+//==============================================================================
+// One block per case:
+//   [name] <panels_wide>x1
+//   16 lines of hex, one RAM row each
+
+typedef struct {
+    char name[40];
+    uint16_t size;
+    uint8_t frame[MAX_FRAME_BYTES];
+} GoldenFrame;
+
+static GoldenFrame golden[CASE_COUNT + 16];
+static unsigned golden_count = 0;
+
+static int load_golden(const char* path) {
+    FILE* f = fopen(path, "r");
+    if (!f) return -1;
+
+    char line[256];
+    GoldenFrame* g = NULL;
+    while (fgets(line, sizeof(line), f)) {
+        unsigned pw;
+        if (line[0] == '#' || line[0] == '\n') continue;
+        if (line[0] == '[') {
+            if (golden_count >= sizeof(golden) / sizeof(golden[0])) break;
+            g = &golden[golden_count++];
+            if (sscanf(line, "[%39[^]]] %ux1", g->name, &pw) != 2 || pw == 0 || pw > MAX_PANELS_WIDE) {
+                fclose(f);
+                return -1;
+            }
+            g->size = 0;
+            continue;
+        }
+        for (char* p = line; g && p[0] && p[1] && p[0] != '\n' && g->size < MAX_FRAME_BYTES; p += 2) {
+            unsigned v;
+            if (sscanf(p, "%2x", &v) != 1) break;
+            g->frame[g->size++] = (uint8_t)v;
+        }
+    }
+    fclose(f);
+    return 0;
+}
+
+static const GoldenFrame* find_golden(const char* name) {
+    for (unsigned i = 0; i < golden_count; i++) {
+        if (strcmp(golden[i].name, name) == 0) return &golden[i];
+    }
+    return NULL;
+}
+
+static int write_golden(const char* path) {
+    FILE* f = fopen(path, "w");
+    if (!f) return -1;
+
+    fprintf(f, "# Golden frames for host/golden_frames.c, written by 'golden_frames --update'.\n");
+    fprintf(f, "# Each block is one VMA419 frame buffer, one line per RAM row.\n");
+    for (unsigned i = 0; i < CASE_COUNT; i++) {
+        uint8_t frame[MAX_FRAME_BYTES];
+        uint16_t lit[4];
+        uint16_t size = render_driver(&cases[i], frame, lit);
+        uint16_t row_bytes = size / 16;
+
+        fprintf(f, "\n[%s] %ux1\n", cases[i].name, cases[i].panels_wide);
+        for (uint16_t j = 0; j < size; j++) {
+            fprintf(f, "%02x%s", frame[j], ((j + 1) % row_bytes) ? "" : "\n");
+        }
+    }
+    fclose(f);
+    return 0;
+}
+
+//==============================================================================
+// REPORTING
+//==============================================================================
+
+static void print_frames(const char* title_a, uint8_t* a, const char* title_b, uint8_t* b, uint8_t panels_wide) {
+    int w = panels_wide * 32;
+    printf("  %-*s  %s\n", w, title_a, b ? title_b : "");
+    for (int y = 0; y < 16; y++) {
+        printf("  ");
+        for (int x = 0; x < w; x++) putchar(ref_get(a, panels_wide, x, y) ? '#' : '.');
+        if (b) {
+            printf("  ");
+            for (int x = 0; x < w; x++) putchar(ref_get(b, panels_wide, x, y) ? '#' : '.');
+        }
+        putchar('\n');
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc == 2 && strcmp(argv[1], "--update") == 0) {
+        if (write_golden(GOLDEN_FILE) != 0) {
+            perror(GOLDEN_FILE);
+            return 2;
+        }
+        printf("Wrote %u frames to %s\n", (unsigned)CASE_COUNT, GOLDEN_FILE);
+        return 0;
+    }
+
+    if (argc == 3 && strcmp(argv[1], "--show") == 0) {
+        for (unsigned i = 0; i < CASE_COUNT; i++) {
+            if (strcmp(cases[i].name, argv[2]) == 0) {
+                uint8_t frame[MAX_FRAME_BYTES];
+                uint16_t lit[4];
+                render_driver(&cases[i], frame, lit);
+                print_frames(cases[i].name, frame, NULL, NULL, cases[i].panels_wide);
+                return 0;
+            }
+        }
+        fprintf(stderr, "No case named %s\n", argv[2]);
+        return 2;
+    }
+
+    if (argc != 1) {
+        fprintf(stderr, "Usage: %s [--update | --show NAME]\n", argv[0]);
+        return 2;
+    }
+
+    if (load_golden(GOLDEN_FILE) != 0) {
+        fprintf(stderr, "Cannot read %s (run with --update to create it)\n", GOLDEN_FILE);
+        return 2;
+    }
+
+    unsigned failed = 0;
+    for (unsigned i = 0; i < CASE_COUNT; i++) {
+        const GoldenCase* c = &cases[i];
+        uint8_t actual[MAX_FRAME_BYTES];
+        uint8_t reference[MAX_FRAME_BYTES];
+        uint16_t lit[4], lit_counted[4] = { 0, 0, 0, 0 };
+        uint16_t size = render_driver(c, actual, lit);
+        render_reference(c, reference);
+
+        // RAM row r is sent in scan phase r % 4
+        for (uint16_t b = 0; b < size; b++) {
+            for (uint8_t bit = 0; bit < 8; bit++) {
+                if (actual[b] & (1 << bit)) lit_counted[(b / (c->panels_wide * 4)) % 4]++;
+            }
+        }
+
+        const GoldenFrame* g = find_golden(c->name);
+        if (!g || g->size != size) {
+            printf("FAIL %s: no golden frame of %u bytes\n", c->name, size);
+            failed++;
+        } else if (memcmp(g->frame, actual, size) != 0) {
+            printf("FAIL %s: output differs from the golden frame\n", c->name);
+            print_frames("golden", (uint8_t*)g->frame, "actual", actual, c->panels_wide);
+            failed++;
+        } else if (memcmp(reference, actual, size) != 0) {
+            printf("FAIL %s: output differs from the reference renderer\n", c->name);
+            print_frames("reference", reference, "actual", actual, c->panels_wide);
+            failed++;
+        } else if (memcmp(lit, lit_counted, sizeof(lit)) != 0) {
+            printf("FAIL %s: lit LEDs per phase %u %u %u %u, the frame has %u %u %u %u\n", c->name,
+                   lit[0], lit[1], lit[2], lit[3],
+                   lit_counted[0], lit_counted[1], lit_counted[2], lit_counted[3]);
+            failed++;
+        }
+    }
+
+    printf("%u of %u frames match\n", (unsigned)CASE_COUNT - failed, (unsigned)CASE_COUNT);
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,336 @@
+/*
+ * host_hal.c - Host (Linux/PC) Stand-In for the ATmega16 Hardware
+ *
+ * See host_hal.h. Only the parts of the chip the firmware actually uses are
+ * modelled, and only as far as the firmware can tell the difference.
+ */
+
+#include <string.h>
+#include <avr/io.h>
+#include "host_hal.h"
+
+volatile uint8_t host_io[HOST_IO_SIZE] __attribute__((aligned(2)));  // TCNT1 is handed out as a uint16_t*
+volatile uint16_t host_spdr;
+volatile int32_t host_udr;
+volatile uint32_t host_time_us;
+
+// Programs without these interrupts leave them undefined (NULL)
+void USART_RXC_vect(void) __attribute__((weak));
+void TIMER1_OVF_vect(void) __attribute__((weak));
+void TIMER2_COMP_vect(void) __attribute__((weak));
+
+static void (*uart_output)(uint8_t byte);
+static void (*event_hook)(const char* signal, uint8_t value);
+static void (*delay_hook)(void);
+static uint32_t timer1_base_us;                   // virtual time of the last restart
+static uint32_t timer1_base_count;                // TCNT1 (and overflows) at that time
+static uint16_t timer1_last;                      // what TCNT1 held after the last update
+static uint16_t timer1_prescaler;                 // 0 = stopped
+static uint32_t timer1_overflows;                 // overflows already signalled
+static uint32_t timer2_base_us;                   // virtual time of the last restart
+static uint8_t timer2_base_count;                 // TCNT2 at that time
+static uint8_t timer2_last;                       // what TCNT2 held after the last update
+static uint16_t timer2_prescaler;                 // 0 = stopped
+static uint8_t timer2_matched;                    // compare match since the restart signalled
+static uint16_t (*adc_input)(uint8_t channel);
+static uint32_t adc_start_us;                     // when the running conversion started
+static uint8_t adc_busy;
+static FILE* trace_file;
+static uint8_t trace_ports[4];                    // last recorded PORTA..PORTD
+static const uint8_t trace_port_addr[4] = { 0x1B, 0x18, 0x15, 0x12 };
+static const char* const trace_port_name[4] = { "PORTA", "PORTB", "PORTC", "PORTD" };
+
+void host_reset(void) {
+    memset((void*)host_io, 0, sizeof(host_io));
+    host_spdr = 0x100;
+    host_udr = 0x10000;
+    UCSRA = (1 << UDRE);                 // transmit buffer empty
+    host_time_us = 0;
+    timer1_base_us = 0;
+    timer1_base_count = 0;
+    timer1_last = 0;
+    timer1_prescaler = 0;
+    timer1_overflows = 0;
+    timer2_base_us = 0;
+    timer2_base_count = 0;
+    timer2_last = 0;
+    timer2_prescaler = 0;
+    timer2_matched = 0;
+    adc_busy = 0;
+    SP = RAMEND;
+    memset(trace_ports, 0, sizeof(trace_ports));
+}
+
+//==============================================================================
+// TRACE
+//==============================================================================
+
+static void host_trace_event(const char* signal, uint8_t value) {
+    if (trace_file) {
+        fprintf(trace_file, "%lu %s %02x\n", (unsigned long)host_time_us, signal, value);
+    }
+    if (event_hook) event_hook(signal, value);
+}
+
+// Start from the current pin state so the decoder knows it
+static void host_trace_start(void) {
+    for (uint8_t i = 0; i < 4; i++) {
+        trace_ports[i] = host_io[trace_port_addr[i]];
+        host_trace_event(trace_port_name[i], trace_ports[i]);
+    }
+}
+
+void host_trace_open(FILE* f) {
+    trace_file = f;
+    if (f) {
+        fprintf(f, "# host_hal trace: <time_us> <signal> <hex value>\n");
+        host_trace_start();
+    }
+}
+
+void host_set_event_hook(void (*hook)(const char* signal, uint8_t value)) {
+    event_hook = hook;
+    if (hook) host_trace_start();
+}
+
+// Record every port that changed since the last call
+static void host_trace_ports(void) {
+    if (!trace_file && !event_hook) return;
+    for (uint8_t i = 0; i < 4; i++) {
+        uint8_t value = host_io[trace_port_addr[i]];
+        if (value != trace_ports[i]) {
+            trace_ports[i] = value;
+            host_trace_event(trace_port_name[i], value);
+        }
+    }
+}
+
+//==============================================================================
+// SPI
+//==============================================================================
+// On the chip a write to SPDR starts 8 clock pulses and sets SPIF when done.
+// Here the firmware's write just lands in host_spdr (a value below 0x100);
+// the next SPDR/SPSR access "shifts" it out and marks it as handled.
+
+static void host_spi_shift(void) {
+    host_trace_ports();                  // pins set up before this byte come first
+    if (host_spdr < 0x100) {
+        host_trace_event("SPDR", (uint8_t)host_spdr);
+        host_spdr |= 0x100;              // transfer complete, SPDR reads back the byte
+        host_io[0x0E] |= (1 << SPIF);
+    }
+}
+
+volatile uint16_t* host_spi_data(void) {
+    host_spi_shift();
+    host_io[0x0E] &= ~(1 << SPIF);       // any SPDR access clears SPIF
+    return &host_spdr;
+}
+
+volatile uint8_t* host_spi_status(void) {
+    host_spi_shift();
+    return &host_io[0x0E];
+}
+
+//==============================================================================
+// UART
+//==============================================================================
+// Transmitting works like SPI: a write leaves a value below 0x10000 (or a
+// negative char) in host_udr, the next access hands it to the output.
+// Sending takes no virtual time, so UDRE is always set.
+
+static void host_uart_send(void) {
+    if ((host_udr & ~0xFF) != 0x10000) {
+        if (uart_output) uart_output((uint8_t)host_udr);
+        host_udr = 0x10000 | (uint8_t)host_udr;
+    }
+}
+
+volatile int32_t* host_uart_data(void) {
+    host_uart_send();
+    UCSRA &= (uint8_t)~(1 << RXC);       // reading UDR empties the receive buffer
+    return &host_udr;
+}
+
+void host_uart_set_output(void (*tx)(uint8_t byte)) {
+    host_uart_send();
+    uart_output = tx;
+}
+
+void host_uart_receive(uint8_t byte) {
+    host_uart_send();
+    if (!(UCSRB & (1 << RXEN))) return;
+    if (UCSRA & (1 << RXC)) {
+        UCSRA |= (1 << DOR);             // previous byte never read: overrun
+        return;
+    }
+    host_udr = 0x10000 | byte;
+    UCSRA = (UCSRA & (uint8_t)~(1 << DOR)) | (1 << RXC);
+
+    if ((UCSRB & (1 << RXCIE)) && (SREG & (1 << SREG_I)) && USART_RXC_vect) {
+        SREG &= (uint8_t)~(1 << SREG_I); // the chip clears I while an ISR runs
+        USART_RXC_vect();
+        host_uart_send();
+        SREG |= (1 << SREG_I);           // RETI
+    }
+}
+
+//==============================================================================
+// TIMER1 (normal mode only)
+//==============================================================================
+// TCNT1 is worked out from the virtual clock whenever it is used. A value the
+// firmware wrote, or a new prescaler, restarts the count from there.
+
+static void host_timer1_update(void) {
+    static const uint16_t prescalers[8] = { 0, 1, 8, 64, 256, 1024, 0, 0 };
+    uint16_t prescaler = prescalers[TCCR1B & 0x07];
+    uint16_t count = _HOST_IO16(0x2C);
+
+    if (count != timer1_last || prescaler != timer1_prescaler) {
+        timer1_base_us = host_time_us;
+        timer1_base_count = count;
+        timer1_overflows = 0;
+        timer1_prescaler = prescaler;
+    }
+    if (prescaler) {
+        uint64_t cycles = (uint64_t)(host_time_us - timer1_base_us) * (F_CPU / 1000000UL);
+        uint32_t total = timer1_base_count + (uint32_t)(cycles / prescaler);
+        count = (uint16_t)total;
+        _HOST_IO16(0x2C) = count;
+
+        while (timer1_overflows < (total >> 16)) {
+            timer1_overflows++;
+            TIFR |= (1 << TOV1);
+            if ((TIMSK & (1 << TOIE1)) && (SREG & (1 << SREG_I)) && TIMER1_OVF_vect) {
+                TIFR &= (uint8_t)~(1 << TOV1);    // cleared when the interrupt runs
+                SREG &= (uint8_t)~(1 << SREG_I);
+                TIMER1_OVF_vect();
+                SREG |= (1 << SREG_I);
+            }
+        }
+    }
+    timer1_last = count;
+}
+
+volatile uint16_t* host_timer1_count(void) {
+    host_timer1_update();
+    return (volatile uint16_t*)&host_io[0x2C];
+}
+
+//==============================================================================
+// TIMER2 (normal mode, compare match only)
+//==============================================================================
+// Worked out like Timer1, but only inside host_delay_us(): the firmware uses
+// it to end a pulse, so what matters is when OCR2 is reached. A wait is
+// split there, so ISR(TIMER2_COMP_vect) sees (and changes) the pins at the
+// right virtual time. Counting past 0xFF wraps without TOV2.
+
+static uint16_t host_timer2_prescaler(void) {
+    static const uint16_t prescalers[8] = { 0, 1, 8, 32, 64, 128, 256, 1024 };
+    return prescalers[TCCR2 & 0x07];
+}
+
+static void host_timer2_update(void) {
+    uint16_t prescaler = host_timer2_prescaler();
+    uint8_t count = TCNT2;
+
+    if (count != timer2_last || prescaler != timer2_prescaler) {
+        timer2_base_us = host_time_us;
+        timer2_base_count = count;
+        timer2_prescaler = prescaler;
+        timer2_matched = 0;
+    }
+    if (prescaler) {
+        uint64_t cycles = (uint64_t)(host_time_us - timer2_base_us) * (F_CPU / 1000000UL);
+        uint64_t total = timer2_base_count + cycles / prescaler;
+        count = (uint8_t)total;
+        TCNT2 = count;
+
+        if (!timer2_matched && timer2_base_count < OCR2 && total >= OCR2) {
+            timer2_matched = 1;
+            TIFR |= (1 << OCF2);
+            if ((TIMSK & (1 << OCIE2)) && (SREG & (1 << SREG_I)) && TIMER2_COMP_vect) {
+                TIFR &= (uint8_t)~(1 << OCF2);    // cleared when the interrupt runs
+                SREG &= (uint8_t)~(1 << SREG_I);
+                TIMER2_COMP_vect();
+                SREG |= (1 << SREG_I);
+                host_trace_ports();
+            }
+            count = TCNT2;
+            if (host_timer2_prescaler() != timer2_prescaler) {
+                timer2_prescaler = host_timer2_prescaler();
+                timer2_base_us = host_time_us;   // stopped or restarted by the ISR
+                timer2_base_count = count;
+            }
+        }
+    }
+    timer2_last = count;
+}
+
+// Virtual microseconds until the next compare match (0xFFFFFFFF = none coming)
+static uint32_t host_timer2_due_us(void) {
+    if (!timer2_prescaler || timer2_matched || timer2_base_count >= OCR2) return 0xFFFFFFFFUL;
+    uint64_t match = (uint64_t)(OCR2 - timer2_base_count) * timer2_prescaler;
+    uint64_t elapsed = (uint64_t)(host_time_us - timer2_base_us) * (F_CPU / 1000000UL);
+    if (elapsed >= match) return 0;
+    return (uint32_t)((match - elapsed + (F_CPU / 1000000UL) - 1) / (F_CPU / 1000000UL));
+}
+
+//==============================================================================
+// ADC (single conversions, no interrupt)
+//==============================================================================
+// A conversion started with ADSC takes 13 ADC clocks of virtual time, then
+// ADCW holds the input for the channel in ADMUX, ADSC clears and ADIF sets.
+
+void host_adc_set_input(uint16_t (*read)(uint8_t channel)) {
+    adc_input = read;
+}
+
+static void host_adc_update(void) {
+    if (!(ADCSRA & (1 << ADEN)) || !(ADCSRA & (1 << ADSC))) {
+        adc_busy = 0;
+        return;
+    }
+    if (!adc_busy) {
+        adc_busy = 1;
+        adc_start_us = host_time_us;
+    }
+    uint32_t clocks = 13UL << ((ADCSRA & 0x07) ? (ADCSRA & 0x07) : 1);
+    if ((uint64_t)(host_time_us - adc_start_us) * (F_CPU / 1000000UL) < clocks) return;
+
+    uint16_t value = adc_input ? adc_input(ADMUX & 0x07) : 512;
+    if (value > 1023) value = 1023;
+    ADCW = (ADMUX & (1 << ADLAR)) ? (uint16_t)(value << 6) : value;
+    ADCSRA = (ADCSRA & (uint8_t)~(1 << ADSC)) | (1 << ADIF);
+    adc_busy = 0;
+}
+
+//==============================================================================
+// TIME
+//==============================================================================
+
+void host_flush(void) {
+    host_spi_shift();
+    host_uart_send();
+}
+
+void host_set_delay_hook(void (*hook)(void)) {
+    delay_hook = hook;
+}
+
+void host_delay_us(uint32_t us) {
+    host_flush();
+    host_timer1_update();                // settings changed since the last wait
+    host_timer2_update();
+    host_adc_update();                   // a conversion started since the last wait
+    while (us > 0) {                     // stop at a Timer2 compare match on the way
+        uint32_t step = host_timer2_due_us();
+        if (step > us) step = us;
+        host_time_us += step;
+        us -= step;
+        host_timer2_update();
+    }
+    host_timer1_update();                // counts and overflows during the wait
+    host_adc_update();
+    if (delay_hook) delay_hook();
+}
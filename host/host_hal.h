@@ -0,0 +1,147 @@
+/*
+ * host_hal.h - Host (Linux/PC) Stand-In for the ATmega16 Hardware
+ *
+ * The firmware sources (vma419.c, VMA419_Font.h, fesb_logo.h, ...) only talk
+ * to the hardware through avr-libc headers. The files in host/avr and
+ * host/util replace those headers, so the same sources compile with the
+ * normal PC compiler. This file is the "hardware" behind them:
+ * - Every I/O register is a byte in host_io[], at its real ATmega16 address
+ * - SPDR and SPSR behave like the SPI peripheral (a write "shifts" at once)
+ * - UDR behaves like the UART: bytes the firmware sends go to a callback,
+ *   host_uart_receive() delivers a byte and runs the RX interrupt
+ * - Timer1 counts with the virtual clock and runs its overflow interrupt
+ * - Timer2 counts during waits and runs its compare match interrupt
+ * - The ADC converts in virtual time, reading host_adc_set_input()
+ * - _delay_ms()/_delay_us() advance a virtual clock instead of busy waiting
+ *
+ * Usage:
+ *   gcc -Ihost -I. -DF_CPU=8000000UL my_tool.c vma419.c host/host_hal.c
+ *
+ * Nothing in here is used by the AVR build.
+ */
+
+#ifndef HOST_HAL_H
+#define HOST_HAL_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+//==============================================================================
+// I/O REGISTER FILE
+//==============================================================================
+
+#define HOST_IO_SIZE 0x40               // ATmega16 has 64 I/O registers
+
+extern volatile uint8_t host_io[HOST_IO_SIZE];
+
+// Data registers with side effects, 0x100 | value means "already handled"
+extern volatile uint16_t host_spdr;
+// Same for UDR, but 0x10000 | value: the firmware may write a negative char
+extern volatile int32_t host_udr;
+
+// Virtual time since reset in microseconds, advanced by the delay functions
+extern volatile uint32_t host_time_us;
+
+//==============================================================================
+// FUNCTIONS
+//==============================================================================
+
+/**
+ * Reset all registers and the virtual clock (like pressing the reset button)
+ */
+void host_reset(void);
+
+/**
+ * Access SPDR/SPSR (used by the register macros in host/avr/io.h)
+ * A byte written to SPDR is "shifted out" the next time either one is used.
+ */
+volatile uint16_t* host_spi_data(void);
+volatile uint8_t* host_spi_status(void);
+
+/**
+ * Access UDR (used by the register macro in host/avr/io.h)
+ * A byte written to UDR goes to the output callback the next time UDR is used.
+ */
+volatile int32_t* host_uart_data(void);
+
+/**
+ * Where the bytes the firmware transmits go (NULL = thrown away, the default)
+ * @param tx Called once per byte, in order
+ */
+void host_uart_set_output(void (*tx)(uint8_t byte));
+
+/**
+ * A byte arrives on RXD
+ *
+ * Sets RXC and, if RXEN, RXCIE and the I bit are set, runs ISR(USART_RXC_vect)
+ * right away with interrupts off, like the chip does. Otherwise the byte waits
+ * in UDR; a second one before UDR is read sets DOR (overrun) and is lost.
+ * @param byte The received byte
+ */
+void host_uart_receive(uint8_t byte);
+
+/**
+ * Access TCNT1 (used by the register macro in host/avr/io.h)
+ * Timer1 runs from the virtual clock with the prescaler in TCCR1B. Time only
+ * moves in the delay functions, so code between two waits takes 0 ticks.
+ * Overflows set TOV1 and run ISR(TIMER1_OVF_vect) if TOIE1 and I are set.
+ */
+volatile uint16_t* host_timer1_count(void);
+
+/**
+ * What the ADC pins read (a light sensor, ...)
+ *
+ * A conversion started with ADSC finishes after 13 ADC clocks of virtual
+ * time with the value for the channel in ADMUX (bits 0-2). There is no ADC
+ * interrupt; firmware polls ADSC or ADIF.
+ * @param read Returns 0-1023 for a channel, NULL = every channel reads 512
+ */
+void host_adc_set_input(uint16_t (*read)(uint8_t channel));
+
+/**
+ * Let virtual time pass (used by _delay_ms/_delay_us in host/util/delay.h)
+ *
+ * Timer2 counts during the wait with the prescaler in TCCR2, starting from
+ * the TCNT2 the firmware left. Reaching OCR2 sets OCF2 and runs
+ * ISR(TIMER2_COMP_vect) at that point of the wait if OCIE2 and I are set.
+ * @param us Microseconds
+ */
+void host_delay_us(uint32_t us);
+
+/**
+ * Finish any pending register side effects (call before inspecting results)
+ */
+void host_flush(void);
+
+/**
+ * Record what the display connector sees to a text trace
+ *
+ * One event per line, "<time_us> <signal> <hex value>":
+ *   SPDR   a byte shifted out over SPI
+ *   PORTx  a new value of an output port (A/B row select, latch and OE live here)
+ * Ports are compared with their last recorded value whenever the firmware
+ * touches SPI or waits, so every change shows up in the order it happened
+ * relative to the SPI bytes. tools/scan_decode.py turns a trace into images.
+ *
+ * @param f Open file to write to, or NULL to stop recording
+ */
+void host_trace_open(FILE* f);
+
+/**
+ * Get the trace events as function calls instead (or as well)
+ * Called with the same signal names and values as the trace lines above,
+ * starting with the current value of every port.
+ * @param hook Function to call, or NULL to stop
+ */
+void host_set_event_hook(void (*hook)(const char* signal, uint8_t value));
+
+/**
+ * Get control back whenever the firmware waits
+ * Called from every _delay_ms()/_delay_us() after host_time_us has moved on.
+ * This is where a host program can poll for input, render, or sleep to keep
+ * the virtual clock in step with real time.
+ * @param hook Function to call, or NULL to stop
+ */
+void host_set_delay_hook(void (*hook)(void));
+
+#endif // HOST_HAL_H
@@ -0,0 +1,207 @@
+/*
+ * scan_record.c - Record the Display Connector Signals of a Scan (host build)
+ *
+ * Draws something with the real driver, runs full 4-phase scans with
+ * vma419_scan_display_quarter() and writes what the panel connector would
+ * see (SPI bytes, A/B, latch, OE) as a host_hal trace. Feed the trace to
+ * tools/scan_decode.py to get back the picture the panel would show.
+ *
+ * Usage:
+ *   ./scan_record [options] [TEXT] > scan.trace
+ *   python3 ../tools/scan_decode.py scan.trace --ascii
+ *
+ * Options:
+ *   -w N         panels side by side (default 1)
+ *   --high N     panels stacked (default 1)
+ *   -x X, -y Y   text position (default 0, 4)
+ *   -n N         number of full scans to record (default 1)
+ *   --logo       draw the FESB logo instead of text
+ *   --diagonals  one diagonal line per panel (shows the panel order)
+ *   --orient N   vma419_set_orientation(): 1 mirror left/right, 2 top/bottom,
+ *                3 turned 180 degrees (default 0)
+ *   --chain MAP  vma419_set_chain_P(): "COLUMN,ROW[,ORIENT] ..." per panel in
+ *                chain order; give tools/scan_decode.py the same --chain
+ *   --vcd        write a VCD file instead, the way a simulator dumps it: SPDR
+ *                only where its value changes, plus an SPIF pulse per byte
+ *                (decode with --strobe SPIF:0)
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "vma419.h"
+#include "VMA419_Font.h"
+#include "fesb_logo.h"
+
+static VMA419_ChainTile chain[256];     // --chain (host "flash" is plain memory)
+
+// "0,0 1,0 1,1,3 0,1,3" -> chain[], returns the number of tiles
+static unsigned parse_chain(const char* text) {
+    unsigned count = 0;
+    while (*text && count < 256) {
+        unsigned column, row, orientation = 0;
+        int used = 0;
+        if (sscanf(text, " %u,%u%n", &column, &row, &used) != 2) break;
+        text += used;
+        if (*text == ',') {
+            if (sscanf(text, ",%u%n", &orientation, &used) != 1) break;
+            text += used;
+        }
+        chain[count++] = (VMA419_ChainTile){ (uint8_t)column, (uint8_t)row, (uint8_t)orientation };
+        while (*text == ' ' || *text == ';') text++;
+    }
+    return count;
+}
+
+//==============================================================================
+// VCD OUTPUT (--vcd)
+//==============================================================================
+// A VCD only records changes, so two equal bytes in a row leave a single SPDR
+// entry; SPIF rises once per byte and is what tells the decoder a byte went out.
+// Every step gets its own time (1 ns units), equal host times are spread out.
+
+static const char* const vcd_names[5] = { "SPDR", "PORTA", "PORTB", "PORTC", "PORTD" };
+static int vcd_values[5];
+static unsigned long long vcd_time;
+
+static void vcd_step(void) {
+    unsigned long long t = (unsigned long long)host_time_us * 1000;
+    vcd_time = (t > vcd_time) ? t : vcd_time + 1;
+    printf("#%llu\n", vcd_time);
+}
+
+static void vcd_value(unsigned index, uint8_t value) {
+    if (vcd_values[index] == value) return;
+    vcd_values[index] = value;
+    printf("b");
+    for (int bit = 7; bit >= 0; bit--) putchar('0' + ((value >> bit) & 1));
+    printf(" %c\n", 'a' + index);
+}
+
+static void vcd_event(const char* signal, uint8_t value) {
+    for (unsigned i = 0; i < 5; i++) {
+        if (strcmp(signal, vcd_names[i]) != 0) continue;
+        vcd_step();
+        if (i == 0) {
+            printf("1s\n");            // Before the value: order within a step is not defined
+            vcd_value(0, value);
+            vcd_step();
+            printf("0s\n");
+        } else {
+            vcd_value(i, value);
+        }
+    }
+}
+
+static void vcd_start(void) {
+    printf("$timescale 1ns $end\n$scope module atmega16 $end\n");
+    for (unsigned i = 0; i < 5; i++) {
+        printf("$var wire 8 %c %s $end\n", 'a' + i, vcd_names[i]);
+        vcd_values[i] = -1;
+    }
+    printf("$var wire 1 s SPIF $end\n$upscope $end\n$enddefinitions $end\n");
+    vcd_time = 0;
+    host_set_event_hook(vcd_event);
+}
+
+// Same wiring as main.c
+static VMA419_PinConfig host_pins = {
+    .a_port_ddr         = &DDRA, .a_port_out         = &PORTA, .a_pin_mask         = (1 << PA1),
+    .b_port_ddr         = &DDRA, .b_port_out         = &PORTA, .b_pin_mask         = (1 << PA2),
+    .latch_clk_port_ddr = &DDRA, .latch_clk_port_out = &PORTA, .latch_clk_pin_mask = (1 << PA4),
+    .oe_port_ddr        = &DDRD, .oe_port_out        = &PORTD, .oe_pin_mask        = (1 << PD7)
+};
+
+int main(int argc, char** argv) {
+    uint8_t panels_wide = 1, panels_high = 1;
+    int16_t x = 0, y = 4;
+    unsigned scans = 1;
+    uint8_t orientation = VMA419_ORIENT_NORMAL;
+    unsigned chain_tiles = 0;
+    const char* text = "HELLO";
+    int vcd = 0;
+    enum { DRAW_TEXT, DRAW_LOGO, DRAW_DIAGONALS } what = DRAW_TEXT;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-w") == 0 && i + 1 < argc) {
+            panels_wide = (uint8_t)atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--high") == 0 && i + 1 < argc) {
+            panels_high = (uint8_t)atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-x") == 0 && i + 1 < argc) {
+            x = (int16_t)atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-y") == 0 && i + 1 < argc) {
+            y = (int16_t)atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            scans = (unsigned)atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--orient") == 0 && i + 1 < argc) {
+            orientation = (uint8_t)atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--chain") == 0 && i + 1 < argc) {
+            chain_tiles = parse_chain(argv[++i]);
+            if (chain_tiles == 0) chain_tiles = 1;  // Let vma419_set_chain_P() refuse it
+        } else if (strcmp(argv[i], "--logo") == 0) {
+            what = DRAW_LOGO;
+        } else if (strcmp(argv[i], "--diagonals") == 0) {
+            what = DRAW_DIAGONALS;
+        } else if (strcmp(argv[i], "--vcd") == 0) {
+            vcd = 1;
+        } else if (argv[i][0] == '-') {
+            fprintf(stderr, "Usage: %s [-w N] [--high N] [-x X] [-y Y] [-n N] [--orient N] [--chain MAP] [--vcd] [--logo | --diagonals | TEXT]\n", argv[0]);
+            return 2;
+        } else {
+            text = argv[i];
+        }
+    }
+
+    VMA419_Display disp;
+    host_reset();
+    if (vma419_init(&disp, &host_pins, panels_wide, panels_high) != 0) {
+        fprintf(stderr, "vma419_init failed\n");
+        return 2;
+    }
+    if (chain_tiles && (chain_tiles != (unsigned)panels_wide * panels_high || vma419_set_chain_P(&disp, chain) != 0)) {
+        fprintf(stderr, "bad chain map (%u tiles for %u panels)\n", chain_tiles, panels_wide * panels_high);
+        return 2;
+    }
+    if (vma419_set_orientation(&disp, orientation) != 0) {
+        fprintf(stderr, "bad orientation %u\n", orientation);
+        return 2;
+    }
+
+    switch (what) {
+        case DRAW_TEXT:
+            vma419_font_draw_string(&disp, x, y, text);
+            break;
+        case DRAW_LOGO:
+            fesb_logo_display(&disp);
+            break;
+        case DRAW_DIAGONALS:
+            for (uint16_t py = 0; py < disp.total_height_pixels; py += 16) {
+                for (uint16_t px = 0; px < disp.total_width_pixels; px++) {
+                    uint16_t panel = px / VMA419_PIXELS_ACROSS_PER_PANEL + panels_wide * (py / 16);
+                    vma419_set_pixel(&disp, px, py + (px % 32) / 2, 1);
+                    // Mark panel N with N+1 dots in the bottom row
+                    if ((px % 32) <= panel * 2 && !(px & 1)) vma419_set_pixel(&disp, px, py + 15, 1);
+                }
+            }
+            break;
+    }
+
+    if (vcd) {
+        vcd_start();
+    } else {
+        host_trace_open(stdout);
+    }
+    for (unsigned n = 0; n < scans; n++) {
+        for (uint8_t cycle = 0; cycle < 4; cycle++) {   // same loop as main.c
+            disp.scan_cycle = cycle;
+            vma419_scan_display_quarter(&disp);
+            _delay_ms(1);
+        }
+    }
+    host_trace_open(NULL);
+    host_set_event_hook(NULL);
+
+    vma419_deinit(&disp);
+    return 0;
+}
@@ -0,0 +1,17 @@
+/*
+ * host/util/delay.h - Busy-wait delays for the host build
+ *
+ * Instead of burning CPU cycles, the delays advance the virtual clock in
+ * host_hal.c (host_time_us). That is also where tools hook in to do
+ * "the rest of the world" while the firmware waits.
+ */
+
+#ifndef HOST_UTIL_DELAY_H
+#define HOST_UTIL_DELAY_H
+
+#include "host_hal.h"
+
+#define _delay_us(us)   host_delay_us((uint32_t)(us))
+#define _delay_ms(ms)   host_delay_us((uint32_t)(ms) * 1000UL)
+
+#endif // HOST_UTIL_DELAY_H
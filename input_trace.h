@@ -0,0 +1,207 @@
+/*
+ * input_trace.h - Timestamped Recording of UART Bytes and Button Edges
+ *
+ * Flicker and glitch reports often depend on exactly when a character or a
+ * button press arrived relative to the scan. This records every received
+ * UART byte and every change of the button pins with a timestamp, so the
+ * same sequence can be played back later (host/emulator --replay) and
+ * studied or benchmarked offline.
+ *
+ * How it works:
+ * 1. input_trace_init() starts Timer1 at F_CPU/64 (8 us per tick at 8 MHz);
+ *    the overflow interrupt extends it to 32 bits (about 9.5 hours)
+ * 2. Every event is stored as 4 bytes in RAM: the ticks since the previous
+ *    event, the kind of event and its value. Gaps longer than 16 bits
+ *    (0.52 s) get an extra WAIT record holding the upper 16 bits.
+ * 3. Recording starts at reset and stops when the buffer is full, so a
+ *    dump always replays from power on
+ * 4. The "/trace" UART command prints the records as text:
+ *      TRACE <count> records, 8 us ticks[, full]
+ *      <kind> <ticks, 4 hex digits> <value, 2 hex digits>
+ *      TRACE end
+ *    kind is U (UART byte), B (button pins, PINC & mask) or W (wait)
+ *
+ * EEPROM was considered, but one EEPROM write takes 8.5 ms, while a byte
+ * arrives every 1 ms at 9600 baud. The RAM buffer costs
+ * 4 * INPUT_TRACE_SIZE bytes and the timebase takes Timer1 and its overflow
+ * interrupt, so the recorder is off unless INPUT_TRACE_SIZE is set (e.g.
+ * -DINPUT_TRACE_SIZE=32). When off, the calls below compile to nothing and
+ * "/trace" answers "TRACE off".
+ *
+ * Usage:
+ *   #define INPUT_TRACE_SIZE 32                  // or -DINPUT_TRACE_SIZE=32
+ *   #include "input_trace.h"
+ *   input_trace_init();                          // first thing in main()
+ *   input_trace_record(INPUT_TRACE_UART, byte);  // in the RX interrupt
+ *   input_trace_buttons(PINC & mask);            // every main loop pass
+ *   input_trace_dump(USART_Transmit);            // on "/trace"
+ *
+ */
+
+#ifndef INPUT_TRACE_H
+#define INPUT_TRACE_H
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/pgmspace.h>
+#include <stdint.h>
+
+#ifndef INPUT_TRACE_SIZE
+#define INPUT_TRACE_SIZE 0          // Records (4 bytes of RAM each), 0 = off
+#endif
+
+#define INPUT_TRACE_UART    'U'     // A byte received over UART
+#define INPUT_TRACE_BUTTONS 'B'     // The button pins changed
+#define INPUT_TRACE_WAIT    'W'     // Upper 16 bits of a long gap
+
+#define INPUT_TRACE_TICK_US 8       // Timer1 at F_CPU/64, 8 MHz
+
+#if INPUT_TRACE_SIZE > 0
+
+typedef struct {
+    uint16_t ticks;                 // Since the previous record
+    uint8_t kind;                   // INPUT_TRACE_UART, _BUTTONS or _WAIT
+    uint8_t value;
+} InputTraceRecord;
+
+InputTraceRecord input_trace[INPUT_TRACE_SIZE];
+uint8_t input_trace_count = 0;
+uint8_t input_trace_full = 0;       // 1 = events were lost
+volatile uint16_t input_trace_overflows = 0;
+uint32_t input_trace_last = 0;      // Time of the previous record, in ticks
+uint8_t input_trace_last_buttons = 0xFF;
+
+//==============================================================================
+// TIMEBASE
+//==============================================================================
+
+ISR(TIMER1_OVF_vect) {
+    input_trace_overflows++;
+}
+
+/**
+ * Start the timebase (Timer1, normal mode, F_CPU/64, overflow interrupt)
+ */
+static inline void input_trace_init(void) {
+    TCCR1A = 0;
+    TCNT1 = 0;
+    TIFR = (1 << TOV1);
+    TIMSK |= (1 << TOIE1);
+    TCCR1B = (1 << CS11) | (1 << CS10);
+}
+
+// 32-bit time in ticks; call with interrupts off
+static inline uint32_t input_trace_now(void) {
+    uint16_t low = TCNT1;
+    uint16_t high = input_trace_overflows;
+    if ((TIFR & (1 << TOV1)) && low < 0x8000) {
+        high++;                     // Overflow the interrupt has not handled yet
+    }
+    return ((uint32_t)high << 16) | low;
+}
+
+//==============================================================================
+// RECORDING
+//==============================================================================
+
+/**
+ * Record one event (safe to call from an interrupt and from the main loop)
+ * @param kind  INPUT_TRACE_UART or INPUT_TRACE_BUTTONS
+ * @param value The byte received / the new button pin state
+ */
+static inline void input_trace_record(uint8_t kind, uint8_t value) {
+    uint8_t sreg = SREG;
+    cli();
+
+    uint32_t now = input_trace_now();
+    uint32_t gap = now - input_trace_last;
+    uint8_t needed = (gap > 0xFFFF) ? 2 : 1;
+
+    if (input_trace_count + needed > INPUT_TRACE_SIZE) {
+        input_trace_full = 1;
+    } else {
+        if (needed == 2) {
+            input_trace[input_trace_count].ticks = (uint16_t)(gap >> 16);
+            input_trace[input_trace_count].kind = INPUT_TRACE_WAIT;
+            input_trace[input_trace_count].value = 0;
+            input_trace_count++;
+        }
+        input_trace[input_trace_count].ticks = (uint16_t)gap;
+        input_trace[input_trace_count].kind = kind;
+        input_trace[input_trace_count].value = value;
+        input_trace_count++;
+        input_trace_last = now;
+    }
+
+    SREG = sreg;
+}
+
+/**
+ * Record the button pins if they changed since the last call
+ * @param pins Current pin state, masked to the button pins
+ */
+static inline void input_trace_buttons(uint8_t pins) {
+    if (pins != input_trace_last_buttons) {
+        input_trace_last_buttons = pins;
+        input_trace_record(INPUT_TRACE_BUTTONS, pins);
+    }
+}
+
+//==============================================================================
+// DUMP
+//==============================================================================
+
+static void input_trace_hex(void (*put)(char), uint16_t value, uint8_t digits) {
+    while (digits > 0) {
+        uint8_t nibble = (value >> (4 * --digits)) & 0x0F;
+        put(nibble < 10 ? '0' + nibble : 'a' + nibble - 10);
+    }
+}
+
+// Send a string stored in flash (PSTR)
+static void input_trace_text_P(void (*put)(char), const char* text) {
+    char c;
+    while ((c = pgm_read_byte(text++)) != 0) put(c);
+}
+
+/**
+ * Print all records (format in the comment at the top)
+ * Recording goes on during the dump; only what was there at the start is printed.
+ * @param put Sends one character (USART_Transmit)
+ */
+static void input_trace_dump(void (*put)(char)) {
+    uint8_t count = input_trace_count;
+
+    input_trace_text_P(put, PSTR("TRACE "));
+    if (count >= 100) put('0' + count / 100);
+    if (count >= 10) put('0' + (count / 10) % 10);
+    put('0' + count % 10);
+    input_trace_text_P(put, PSTR(" records, 8 us ticks"));
+    if (input_trace_full) input_trace_text_P(put, PSTR(", full"));
+    input_trace_text_P(put, PSTR("\r\n"));
+
+    for (uint8_t i = 0; i < count; i++) {
+        put((char)input_trace[i].kind);
+        put(' ');
+        input_trace_hex(put, input_trace[i].ticks, 4);
+        put(' ');
+        input_trace_hex(put, input_trace[i].value, 2);
+        input_trace_text_P(put, PSTR("\r\n"));
+    }
+    input_trace_text_P(put, PSTR("TRACE end\r\n"));
+}
+
+#else // INPUT_TRACE_SIZE == 0
+
+static inline void input_trace_init(void) {}
+static inline void input_trace_record(uint8_t kind, uint8_t value) { (void)kind; (void)value; }
+static inline void input_trace_buttons(uint8_t pins) { (void)pins; }
+static inline void input_trace_dump(void (*put)(char)) {
+    const char* text = PSTR("TRACE off\r\n");
+    char c;
+    while ((c = pgm_read_byte(text++)) != 0) put(c);
+}
+
+#endif // INPUT_TRACE_SIZE
+
+#endif // INPUT_TRACE_H
@@ -16,7 +16,7 @@
  * 4. Physical buttons control speed and text position
  * 
  * Hardware needed:
- * - VMA419 32x16 red LED matrix panel
+ * - VMA419 32x16 red LED matrix panel (or a wall of them, see DISPLAY_PANELS_WIDE)
  * - 5 push buttons connected to pins PC0, PC1, PC2, PC6, PC7
  * - USB/serial connection to computer
  * 
@@ -28,13 +28,43 @@
 #include <util/delay.h>    // Functions to create time delays
 #include <string.h>        // Text manipulation functions (strlen, strcpy, etc.)
 #include <avr/interrupt.h> // Functions to handle interrupts
+#include <avr/pgmspace.h>  // Text kept in flash instead of SRAM (PSTR)
 #include "vma419.h"        // Our custom LED matrix driver
-#include "VMA419_Font.h"   // Font data for displaying text
+#include "VMA419_FontCreator.h"  // Proportional text with the DMD419 fonts
+#include "Cpp_Lib/DMD419/Arial_Black_16_ISO_8859_1.h" // Font of the scrolling text (with accented letters)
 #include "fesb_logo.h"     // University logo bitmap data
+#include "mem_stats.h"     // Stack and heap usage measurement
+#include "input_trace.h"   // Timestamped log of UART bytes and button presses
+#include "utf8_latin1.h"   // Accented letters typed in the terminal (UTF-8) to font codes
+#include "ambient_light.h" // Brightness from a light sensor on PA0
 
 #define BAUD 9600         // Communication speed: 9600 bits per second
 #define MYUBRR ((F_CPU / (16UL * BAUD)) - 1) // Math to calculate baud rate = 51
 
+#define SCROLL_FONT Arial_Black_16_ISO_8859_1  // Any FontCreator font from Cpp_Lib/DMD419 works here
+
+// LED on-time per scan phase (see vma419_set_oe_timing in vma419.h)
+#define OE_ON_TICKS            VMA419_OE_PHASE_TICKS  // 960 us of each 1 ms phase (ambient_light.h takes over if enabled)
+#define OE_DROOP_PERCENT       10   // How much dimmer a fully lit phase gets on this supply
+#define OE_CURRENT_CAP_PERCENT 100  // Lower this for a weak supply (100 = no cap)
+
+// How the panels are mounted (see vma419_set_orientation in vma419.h)
+#define DISPLAY_ORIENTATION    VMA419_ORIENT_NORMAL  // VMA419_ORIENT_ROTATE_180 if upside down
+
+// Panel wall: panels side by side and stacked (4x2 and 8x1 need 512 bytes
+// of frame buffer). If the cable does not run left to right, top to bottom,
+// point DISPLAY_CHAIN at a PROGMEM VMA419_ChainTile map (see
+// vma419_set_chain_P in vma419.h for a serpentine example).
+#ifndef DISPLAY_PANELS_WIDE
+#define DISPLAY_PANELS_WIDE    1
+#endif
+#ifndef DISPLAY_PANELS_HIGH
+#define DISPLAY_PANELS_HIGH    1
+#endif
+#ifndef DISPLAY_CHAIN
+#define DISPLAY_CHAIN          NULL
+#endif
+
 // ===============================================
 // MAIN VARIABLES - THE IMPORTANT STUFF
 // ===============================================
@@ -42,10 +72,12 @@ VMA419_Display dmd_display;  // This controls our LED matrix
 
 // Settings for the scrolling text
 char scroll_text[32] = "WELCOME ERASMUS STUDENTS";  // The message to display
-int16_t scroll_position = 32;    // Where the text starts (off the right side)
+int16_t scroll_position = DISPLAY_PANELS_WIDE * VMA419_PIXELS_ACROSS_PER_PANEL;  // Where the text starts (off the right side)
 uint8_t scroll_speed = 30;       // How fast it scrolls (lower = faster)
 int8_t scroll_direction = -1;    // Which way: -1 = right to left, 1 = left to right
-int8_t text_y_offset = 4;        // How high up the text appears (0 = top, 15 = bottom)
+int8_t text_y_offset = 0;        // How high up the text appears (0 = top, display height - 1 = bottom); 16 px font
+VMA419_FCFont scroll_font;       // The font, selected at startup
+int16_t scroll_text_width = 0;   // Width of scroll_text in pixels, measured whenever it changes
 // ===============================================
 // SERIAL COMMUNICATION BUFFER
 // ===============================================
@@ -90,6 +122,32 @@ void USART_SendString(const char* str) {
     }
 }
 
+// Send a text stored in flash (PSTR("...")): it takes no SRAM, unlike a
+// plain "..." literal, which the startup code copies into SRAM
+void USART_SendString_P(const char* str) {
+    char c;
+    while ((c = pgm_read_byte(str++))) {
+        USART_Transmit(c);
+    }
+}
+
+// Send a number as decimal text (0 to 65535), without leading zeros
+void USART_SendNumber(uint16_t value) {
+    char digits[5];
+    uint8_t count = 0;
+
+    // Collect the digits from right to left
+    do {
+        digits[count++] = '0' + (value % 10);
+        value /= 10;
+    } while (value > 0);
+
+    // Send them back in the right order
+    while (count > 0) {
+        USART_Transmit(digits[--count]);
+    }
+}
+
 // ===============================================
 // AUTOMATIC MESSAGE HANDLER (INTERRUPT FUNCTION)
 // ===============================================
@@ -97,6 +155,7 @@ void USART_SendString(const char* str) {
 // It's like having a secretary that collects your mail while you're busy with other work
 ISR(USART_RXC_vect) {
     char received_char = UDR;  // Get the character that just arrived
+    input_trace_record(INPUT_TRACE_UART, received_char);  // Log it for /trace
     
     // Echo it back to the computer so the user can see what they typed
     USART_Transmit(received_char);
@@ -108,9 +167,21 @@ ISR(USART_RXC_vect) {
             // Copy everything from our temporary buffer into the final message
             uint8_t msg_index = 0;
             uint8_t temp_tail = uart_rx_tail;
+            uint8_t line_length = (uart_rx_head - uart_rx_tail + UART_BUFFER_SIZE) % UART_BUFFER_SIZE;
+            uint8_t copy_length = line_length;
+            
+            // Too long: cut before the last whole character that fits, never
+            // in the middle of an accented letter (UTF-8 continuation byte)
+            if (copy_length > sizeof(uart_message) - 1) {
+                copy_length = sizeof(uart_message) - 1;
+                while (copy_length > 0 &&
+                       (uart_rx_buffer[(uart_rx_tail + copy_length) % UART_BUFFER_SIZE] & 0xC0) == 0x80) {
+                    copy_length--;
+                }
+            }
             
             // Copy character by character until we reach the end
-            while (temp_tail != uart_rx_head && msg_index < sizeof(uart_message) - 1) {
+            while (msg_index < copy_length) {
                 uart_message[msg_index] = uart_rx_buffer[temp_tail];
                 temp_tail = (temp_tail + 1) % UART_BUFFER_SIZE;  // Move to next position (wrapping around if needed)
                 msg_index++;
@@ -131,15 +202,22 @@ ISR(USART_RXC_vect) {
     else if (received_char == 8 || received_char == 127) {
         // User pressed Backspace or Delete - remove the last character they typed
         if (uart_rx_head != uart_rx_tail) {  // Only if there's something to delete
-            uart_rx_head = (uart_rx_head - 1 + UART_BUFFER_SIZE) % UART_BUFFER_SIZE;
+            // An accented letter is several bytes (UTF-8): remove its
+            // continuation bytes (10xxxxxx) and then its first byte
+            char removed;
+            do {
+                uart_rx_head = (uart_rx_head - 1 + UART_BUFFER_SIZE) % UART_BUFFER_SIZE;
+                removed = uart_rx_buffer[uart_rx_head];
+            } while (uart_rx_head != uart_rx_tail && (removed & 0xC0) == 0x80);
             // Send backspace sequence to the computer so it erases on screen too
             USART_Transmit('\b');  // Move cursor back
             USART_Transmit(' ');   // Overwrite with space
             USART_Transmit('\b');  // Move cursor back again
         }
     }
-    else if (received_char >= 32 && received_char <= 126) {
-        // It's a normal printable character (letters, numbers, symbols)
+    else if ((uint8_t)received_char >= 32) {
+        // It's a normal printable character (letters, numbers, symbols), or
+        // a byte of an accented letter (UTF-8, 128-255), decoded at Enter
         uint8_t next_head = (uart_rx_head + 1) % UART_BUFFER_SIZE;
         
         // Make sure our buffer isn't full
@@ -152,6 +230,9 @@ ISR(USART_RXC_vect) {
     // Ignore any other control characters (like Ctrl+C, weird escape sequences, etc.)
 }
 
+// Timer2 compare match ends each scan phase's OE pulse (see vma419_set_oe_timing)
+VMA419_OE_TIMER2_ISR()
+
 // ===============================================
 // HELPER FUNCTIONS FOR MESSAGE HANDLING
 // ===============================================
@@ -162,12 +243,60 @@ uint8_t uart_message_available(void) {
 }
 
 // Get the complete message and mark it as read
+// The UTF-8 from the terminal is turned into one font code per character
+// here, once, so drawing and measuring never have to decode it
 void uart_get_message(char* buffer, uint8_t max_length) {
     if (uart_message_ready) {
-        strncpy(buffer, uart_message, max_length - 1);  // Copy the message safely
-        buffer[max_length - 1] = '\0';                  // Make sure it ends properly
-        uart_message_ready = 0;                         // Mark as read
+        utf8_to_latin1(buffer, uart_message, max_length);   // Copy and decode, always terminated
+        uart_message_ready = 0;                             // Mark as read
+    }
+}
+
+// Send one "name: value bytes" line of the stats report (name in flash)
+static void send_stat_line(const char* name, uint16_t value) {
+    USART_SendString_P(name);
+    USART_SendNumber(value);
+    USART_SendString_P(PSTR(" bytes\r\n"));
+}
+
+// Handle special commands typed via UART (they all start with '/')
+// Returns 1 if the message was a command, 0 if it should be displayed as text
+uint8_t handleUartCommand(const char* message) {
+    if (message[0] != '/') {
+        return 0; // Normal text message
     }
+
+    if (strcmp_P(message, PSTR("/stats")) == 0) {
+        // Report how much RAM the stack and heap have used so far
+        MemStats stats;
+        mem_stats_read(&stats);
+
+        USART_SendString_P(PSTR("--- Memory stats ---\r\n"));
+        send_stat_line(PSTR("Stack peak:   "), stats.stack_peak);
+        send_stat_line(PSTR("Stack now:    "), stats.stack_current);
+        send_stat_line(PSTR("Heap used:    "), stats.heap_used);
+        send_stat_line(PSTR("Free now:     "), stats.free_current);
+        send_stat_line(PSTR("Free minimum: "), stats.free_minimum);
+    } else if (strcmp_P(message, PSTR("/trace")) == 0) {
+        // Print the recorded UART bytes and button presses (see input_trace.h)
+        input_trace_dump(USART_Transmit);
+    } else if (strcmp_P(message, PSTR("/light")) == 0) {
+        // Light sensor and the on-time it gives (see ambient_light.h)
+#if AMBIENT_LIGHT_ENABLE
+        USART_SendString_P(PSTR("Light: "));
+        USART_SendNumber(ambient_light.sum >> AMBIENT_LIGHT_FILTER_SHIFT);
+        USART_SendString_P(PSTR(" of 1023, on-time "));
+        USART_SendNumber(ambient_light.on_ticks * VMA419_OE_TICK_US);
+        USART_SendString_P(PSTR(" us per phase\r\n"));
+#else
+        USART_SendString_P(PSTR("Light: off\r\n"));
+#endif
+    } else {
+        USART_SendString_P(PSTR("Unknown command. Try /stats, /trace or /light\r\n"));
+    }
+
+    USART_SendString("> ");
+    return 1;
 }
 
 // Update what's shown on the LED display with a new message
@@ -189,13 +318,14 @@ void updateDisplayMessage(const char* message) {
     // Add a space at the end for smooth scrolling (so text doesn't run together)
     scroll_text[msg_len] = ' ';
     scroll_text[msg_len + 1] = '\0';
+    scroll_text_width = vma419_fc_string_width(&scroll_font, scroll_text);
     
     // Start scrolling from the right side again
-    scroll_position = 32;
+    scroll_position = dmd_display.total_width_pixels;
     
     // Let the user know we got their message
     USART_SendString("Updated: ");
-    USART_SendString(scroll_text);
+    latin1_send_utf8(USART_Transmit, scroll_text);  // Back to UTF-8 for the terminal
     USART_SendString("\r\n> ");
 }
 
@@ -220,6 +350,9 @@ VMA419_PinConfig dmd_pins = {
 // MAIN PROGRAM - THIS IS WHERE EVERYTHING STARTS
 // ===============================================
 int main(void) {
+    // Start the clock for the input recorder, so its times count from reset
+    input_trace_init();
+
     // Wait a moment for the electronics to settle down when first powered on
     _delay_ms(100);
     
@@ -262,17 +395,25 @@ int main(void) {
     USART_SendString("\r\n> ");
     
     // Initialize the LED matrix display system
-    if (vma419_init(&dmd_display, &dmd_pins, 1, 1) != 0) {
+    if (vma419_init(&dmd_display, &dmd_pins, DISPLAY_PANELS_WIDE, DISPLAY_PANELS_HIGH) != 0) {
         // If initialization fails, tell the user and stop the program
         USART_SendString("ERROR: Display initialization failed!\r\n");
         while(1);  // Infinite loop - program stops here
     }
 
+    vma419_set_chain_P(&dmd_display, DISPLAY_CHAIN);             // How the cable runs through a wall
+    vma419_set_orientation(&dmd_display, DISPLAY_ORIENTATION);  // Turned at scan time, drawn as usual
+
+    // Time the LEDs of each scan phase by how many of them are lit (Timer2)
+    vma419_set_oe_timing(&dmd_display, OE_ON_TICKS, OE_DROOP_PERCENT, OE_CURRENT_CAP_PERCENT);
+    ambient_light_init(&dmd_display);  // With AMBIENT_LIGHT_ENABLE the light sensor sets the on-time from now on
+
     // Start with a blank display
     vma419_clear(&dmd_display);
     
-    // Set up the font system for displaying text
-    vma419_font_init(&dmd_display);
+    // Set up the font for the scrolling text and measure the first message
+    vma419_fc_select(&scroll_font, SCROLL_FONT);
+    scroll_text_width = vma419_fc_string_width(&scroll_font, scroll_text);
     
     // ===============================================
     // SHOW UNIVERSITY LOGO ON STARTUP
@@ -324,10 +465,18 @@ int main(void) {
     // 2. Button presses
     // 3. Updating the LED display with scrolling text
     while(1) {
+        // Log button changes for /trace (the same pins the code below reads)
+        input_trace_buttons(PINC & ((1 << PC0) | (1 << PC1) | (1 << PC2) | (1 << PC6) | (1 << PC7)));
+
+        // Follow the ambient light (one ADC sample per pass, no waiting)
+        ambient_light_update(&dmd_display);
+
         // Check if someone sent us a new message via the computer
         if (uart_message_available()) {
             uart_get_message(new_message, sizeof(new_message));
-            updateDisplayMessage(new_message); // Update what's shown on the LED display
+            if (!handleUartCommand(new_message)) {
+                updateDisplayMessage(new_message); // Update what's shown on the LED display
+            }
         }
 
         // ===============================================
@@ -377,10 +526,10 @@ int main(void) {
                 
                 // Restart scrolling from the appropriate side
                 if (scroll_direction < 0) {
-                    scroll_position = 32;  // Right to left: start from right
+                    scroll_position = dmd_display.total_width_pixels;  // Right to left: start from right
                     USART_SendString("Dir: L<-R\r\n> ");
                 } else {
-                    scroll_position = -strlen(scroll_text) * 6;  // Left to right: start from left
+                    scroll_position = -scroll_text_width;  // Left to right: start from left
                     USART_SendString("Dir: L->R\r\n> ");
                 }
                 button_debounce_timer = 50;
@@ -402,7 +551,7 @@ int main(void) {
             
             // PC7: Text Down button
             if (button_pc7_prev == 1 && button_pc7_current == 0) {
-                if (text_y_offset < 15) {
+                if (text_y_offset < (int16_t)dmd_display.total_height_pixels - 1) {
                     text_y_offset++;
                     USART_SendString("Text Down: Y=");
                     USART_Transmit('0' + (text_y_offset / 10));
@@ -430,7 +579,7 @@ int main(void) {
         // ===============================================
         // Clear the display and draw the current text
         vma419_clear(&dmd_display);
-        vma419_font_draw_string(&dmd_display, scroll_position, text_y_offset, scroll_text);
+        vma419_fc_draw_string(&dmd_display, &scroll_font, scroll_position, text_y_offset, scroll_text);
         
         // Refresh the display using 4-phase multiplexing (1ms per phase = 250Hz refresh rate)
         for(uint8_t cycle = 0; cycle < 4; cycle++) {
@@ -446,19 +595,16 @@ int main(void) {
             refresh_counter = 0;
             scroll_position += scroll_direction;  // Move text one pixel
             
-            // Calculate text width (each character is 6 pixels wide)
-            int16_t text_width = strlen(scroll_text) * 6;
-            
-            // Wrap around when text scrolls off the edge
+            // Wrap around when text scrolls off the edge (width measured when the text changed)
             if (scroll_direction < 0) {
                 // Right to left - restart from right when text disappears off left
-                if(scroll_position < -text_width) {
-                    scroll_position = 32;
+                if(scroll_position < -scroll_text_width) {
+                    scroll_position = dmd_display.total_width_pixels;
                 }
             } else {
                 // Left to right - restart from left when text disappears off right
-                if(scroll_position > 32) {
-                    scroll_position = -text_width;
+                if(scroll_position > (int16_t)dmd_display.total_width_pixels) {
+                    scroll_position = -scroll_text_width;
                 }
             }
         }
@@ -0,0 +1,141 @@
+/*
+ * mem_stats.h - Stack and Heap High-Water-Mark Instrumentation
+ *
+ * The ATmega16 only has 1 KB of SRAM, and it is shared by:
+ * - Global variables (.data and .bss, including all the string literals)
+ * - The heap (the frame buffer is allocated with malloc() in vma419_init())
+ * - The stack (main()'s local buffers, function calls and the UART interrupt)
+ *
+ * The heap grows up from the end of the globals and the stack grows down from
+ * the top of RAM. If they ever meet, the firmware silently corrupts itself.
+ *
+ * How the measurement works ("stack painting"):
+ * 1. Before main() runs, every free byte between the globals and the top of
+ *    RAM is filled with a known pattern (MEM_STATS_PAINT_BYTE)
+ * 2. Whenever the stack or the heap uses a byte, the pattern is overwritten
+ * 3. Later we search for the first byte that still holds the pattern - the
+ *    untouched gap tells us how close the stack and heap have ever come
+ *
+ * Usage:
+ *   #include "mem_stats.h"
+ *   MemStats stats;
+ *   mem_stats_read(&stats);   // Painting happens automatically at reset
+ *
+ */
+
+#ifndef MEM_STATS_H
+#define MEM_STATS_H
+
+#include <avr/io.h>
+#include <stdint.h>
+
+#define MEM_STATS_PAINT_BYTE 0xC5  // Pattern written into unused RAM at startup
+
+extern uint8_t _end;         // First byte after all global variables
+extern uint8_t __heap_start; // Where malloc() starts handing out memory
+extern uint8_t __stack;      // Top of RAM (RAMEND), where the stack starts
+extern char* __brkval;       // Current end of the heap (0 until the first malloc)
+
+// Snapshot of the memory situation, all values are in bytes
+typedef struct {
+    uint16_t stack_peak;     // Deepest the stack has ever been since reset
+    uint16_t stack_current;  // How much stack is in use right now
+    uint16_t heap_used;      // Heap extent (everything malloc() has handed out)
+    uint16_t free_current;   // Gap between heap end and stack pointer right now
+    uint16_t free_minimum;   // Smallest gap ever seen (never-touched painted bytes)
+} MemStats;
+
+#if defined(__AVR__)
+
+//==============================================================================
+// MEMORY LAYOUT SYMBOLS (provided by the linker and avr-libc)
+//==============================================================================
+
+//==============================================================================
+// STARTUP PAINTING
+//==============================================================================
+
+/**
+ * Fill all free RAM with MEM_STATS_PAINT_BYTE
+ *
+ * This runs automatically from the .init1 section, before the C runtime sets
+ * up the stack, copies .data or calls main(). It must not use the stack
+ * itself, which is why it is written in assembly and declared naked.
+ */
+void mem_stats_paint(void) __attribute__((naked, used, section(".init1")));
+
+void mem_stats_paint(void) {
+    __asm__ volatile (
+        "    ldi r30, lo8(_end)      \n"  // Z = first free byte
+        "    ldi r31, hi8(_end)      \n"
+        "    ldi r24, %0             \n"  // r24 = paint pattern
+        "    ldi r25, hi8(__stack)   \n"
+        "    rjmp 2f                 \n"
+        "1:  st Z+, r24              \n"  // Paint one byte and move up
+        "2:  cpi r30, lo8(__stack)   \n"  // Stop after the top of RAM
+        "    cpc r31, r25            \n"
+        "    brlo 1b                 \n"
+        "    breq 1b                 \n"
+        :
+        : "M" (MEM_STATS_PAINT_BYTE)
+    );
+}
+
+//==============================================================================
+// RUNTIME QUERY
+//==============================================================================
+
+/**
+ * Find the current end of the heap
+ * @return Address of the first byte above everything malloc() has handed out
+ */
+static inline uint8_t* mem_stats_heap_end(void) {
+    return (__brkval != 0) ? (uint8_t*)__brkval : &__heap_start;
+}
+
+/**
+ * Measure stack and heap usage
+ *
+ * Scans upward from the end of the heap until it finds a byte that was
+ * overwritten by the stack. Takes about 5 cycles per untouched byte, so
+ * call it from the main loop (for example on a UART command), not from
+ * an interrupt.
+ *
+ * @param stats Where to store the measurements
+ */
+static inline void mem_stats_read(MemStats* stats) {
+    uint8_t* heap_end = mem_stats_heap_end();
+    uint8_t* stack_pointer = (uint8_t*)SP;
+    uint8_t* stack_top = &__stack;
+
+    // Walk up through the untouched (still painted) bytes
+    uint8_t* p = heap_end;
+    while (p <= stack_pointer && *p == MEM_STATS_PAINT_BYTE) {
+        p++;
+    }
+
+    stats->stack_peak    = (uint16_t)(stack_top - p) + 1;
+    stats->stack_current = (uint16_t)(stack_top - stack_pointer);
+    stats->heap_used     = (uint16_t)(heap_end - &__heap_start);
+    stats->free_current  = (stack_pointer > heap_end) ? (uint16_t)(stack_pointer - heap_end) : 0;
+    stats->free_minimum  = (uint16_t)(p - heap_end);
+}
+
+#else
+
+//==============================================================================
+// HOST BUILD (see host/)
+//==============================================================================
+// A PC has no AVR memory map to measure, so everything reads as 0
+
+static inline void mem_stats_read(MemStats* stats) {
+    stats->stack_peak    = 0;
+    stats->stack_current = 0;
+    stats->heap_used     = 0;
+    stats->free_current  = 0;
+    stats->free_minimum  = 0;
+}
+
+#endif // __AVR__
+
+#endif // MEM_STATS_H
@@ -0,0 +1,421 @@
+#!/usr/bin/env python3
+"""
+bitmap_compile.py - Turn an image into a PROGMEM bitmap for vma419_draw_bitmap_P()
+
+What this tool does:
+- Reads PBM, PGM (plain or binary) or PNG images (8-bit or less per channel,
+  grey, RGB, palette, with or without alpha; not interlaced)
+- Makes every pixel on or off, with a threshold or Floyd-Steinberg dithering
+- Writes a C header with a PROGMEM array for vma419_draw_bitmap_P()
+
+Pixels darker than the threshold light the LED ("ink" is on), which suits
+logos drawn dark on white. Use --invert for images drawn light on black.
+Transparent PNG pixels are off.
+
+Output formats (the first array byte, see VMA419_BITMAP_* in vma419.h):
+- raw   row by row, (width+7)/8 bytes per row, MSB = leftmost pixel
+- wire  the frame buffer bytes in the order vma419_scan_display_quarter()
+        sends them; only for pictures exactly the size of the display
+        (width a multiple of 32, height a multiple of 16), drawn at 0, 0
+- rle   raw bytes, run-length compressed (n < 128: n+1 bytes as they are,
+        n >= 128: next byte n-125 times)
+- auto  (default) the smaller of raw and rle
+
+Every array starts with a 4-byte header: format, width (2 bytes, low byte
+first), height. The header file also gets NAME_WIDTH/NAME_HEIGHT defines and
+a picture of the result as a comment, so changes show up in a diff.
+
+Usage:
+  python3 tools/bitmap_compile.py logo.png -o my_logo.h
+  python3 tools/bitmap_compile.py photo.pgm --dither --invert -o icon.h --name icon
+  python3 tools/bitmap_compile.py logo.pbm --format wire --preview
+"""
+
+import argparse
+import os
+import re
+import struct
+import sys
+import zlib
+
+FORMAT_RAW = 0
+FORMAT_WIRE = 1
+FORMAT_RLE = 2
+FORMAT_NAMES = {FORMAT_RAW: "RAW", FORMAT_WIRE: "WIRE", FORMAT_RLE: "RLE"}
+
+PANEL_WIDTH = 32
+PANEL_HEIGHT = 16
+
+# (byte column, row index k) of each of the 16 bytes of one panel and phase,
+# same as vma419_scan_display_quarter() and tools/scan_decode.py
+WIRE_ORDER = [
+    (0, 3), (0, 2), (1, 3), (1, 2), (0, 1), (0, 0), (1, 1), (1, 0),
+    (2, 3), (2, 2), (3, 3), (3, 2), (2, 1), (2, 0), (3, 1), (3, 0),
+]
+
+
+#==============================================================================
+# IMAGE READERS (all return width, height, rows of (grey 0-255, alpha 0-255))
+#==============================================================================
+
+def read_netpbm(data):
+    """P1/P2 (plain) and P4/P5 (binary) PBM/PGM"""
+    magic = data[:2]
+    if magic not in (b"P1", b"P2", b"P4", b"P5"):
+        raise ValueError("not a PBM/PGM file")
+
+    # Header fields, skipping comments
+    pos = 2
+    fields = []
+    wanted = 2 if magic in (b"P1", b"P4") else 3
+    while len(fields) < wanted:
+        m = re.compile(rb"\s*(#[^\n]*\n\s*)*(\d+)").match(data, pos)
+        if not m:
+            raise ValueError("bad PBM/PGM header")
+        fields.append(int(m.group(2)))
+        pos = m.end()
+    width, height = fields[0], fields[1]
+    maxval = fields[2] if wanted == 3 else 1
+    pos += 1                                    # the single whitespace before binary data
+
+    if magic == b"P4":
+        stride = (width + 7) // 8
+        bits = data[pos:pos + stride * height]
+        rows = [[0 if bits[y * stride + x // 8] >> (7 - x % 8) & 1 else 255 for x in range(width)]
+                for y in range(height)]
+    elif magic == b"P5":
+        size = 2 if maxval > 255 else 1
+        raw = data[pos:pos + width * height * size]
+        values = raw if size == 1 else struct.unpack(">%dH" % (width * height), raw)
+        rows = [[values[y * width + x] * 255 // maxval for x in range(width)] for y in range(height)]
+    else:
+        tokens = re.sub(rb"#[^\n]*", b"", data[pos - 1:]).split()
+        if magic == b"P1":
+            # Plain PBM may also run the digits together
+            tokens = list(b"".join(tokens).decode())
+            values = [0 if t == "1" else 255 for t in tokens]
+        else:
+            values = [int(t) * 255 // maxval for t in tokens]
+        rows = [values[y * width:(y + 1) * width] for y in range(height)]
+
+    return width, height, [[(v, 255) for v in row] for row in rows]
+
+
+def png_unfilter(raw, width, height, bpp, stride):
+    """Undo the PNG row filters, returns a list of row byte strings"""
+    rows = []
+    prev = bytearray(stride)
+    pos = 0
+    for _ in range(height):
+        kind = raw[pos]
+        line = bytearray(raw[pos + 1:pos + 1 + stride])
+        pos += 1 + stride
+        for i in range(stride):
+            a = line[i - bpp] if i >= bpp else 0
+            b = prev[i]
+            c = prev[i - bpp] if i >= bpp else 0
+            if kind == 1:
+                line[i] = (line[i] + a) & 0xFF
+            elif kind == 2:
+                line[i] = (line[i] + b) & 0xFF
+            elif kind == 3:
+                line[i] = (line[i] + (a + b) // 2) & 0xFF
+            elif kind == 4:
+                p = a + b - c
+                pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+                pred = a if pa <= pb and pa <= pc else (b if pb <= pc else c)
+                line[i] = (line[i] + pred) & 0xFF
+        rows.append(line)
+        prev = line
+    return rows
+
+
+def read_png(data):
+    if data[:8] != b"\x89PNG\r\n\x1a\n":
+        raise ValueError("not a PNG file")
+    pos = 8
+    idat = b""
+    palette = []
+    trns = b""
+    while pos < len(data):
+        length, kind = struct.unpack(">I4s", data[pos:pos + 8])
+        body = data[pos + 8:pos + 8 + length]
+        pos += 12 + length
+        if kind == b"IHDR":
+            width, height, depth, color, _, _, interlace = struct.unpack(">IIBBBBB", body)
+        elif kind == b"PLTE":
+            palette = [tuple(body[i:i + 3]) for i in range(0, len(body), 3)]
+        elif kind == b"tRNS":
+            trns = body
+        elif kind == b"IDAT":
+            idat += body
+        elif kind == b"IEND":
+            break
+
+    if interlace:
+        raise ValueError("interlaced PNG is not supported, save it without interlacing")
+    if depth > 8:
+        raise ValueError("16-bit PNG is not supported, save it with 8 bits per channel")
+    channels = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}[color]
+    bits = depth * channels
+    stride = (width * bits + 7) // 8
+    lines = png_unfilter(zlib.decompress(idat), width, height, max(1, bits // 8), stride)
+
+    def sample(line, index):
+        """index-th sample of 'depth' bits in a row"""
+        if depth == 8:
+            return line[index]
+        bit = index * depth
+        return (line[bit // 8] >> (8 - depth - bit % 8)) & ((1 << depth) - 1)
+
+    scale = 255 // ((1 << depth) - 1)
+    rows = []
+    for line in lines:
+        row = []
+        for x in range(width):
+            s = [sample(line, x * channels + i) for i in range(channels)]
+            if color == 3:
+                r, g, b = palette[s[0]]
+                alpha = trns[s[0]] if s[0] < len(trns) else 255
+            elif color in (0, 4):
+                r = g = b = s[0] * scale
+                alpha = s[1] if color == 4 else 255
+            else:
+                r, g, b = s[0], s[1], s[2]
+                alpha = s[3] if color == 6 else 255
+            row.append(((r * 299 + g * 587 + b * 114) // 1000, alpha))
+        rows.append(row)
+    return width, height, rows
+
+
+def read_image(path):
+    with open(path, "rb") as f:
+        data = f.read()
+    if data[:8] == b"\x89PNG\r\n\x1a\n":
+        return read_png(data)
+    return read_netpbm(data)
+
+
+#==============================================================================
+# THRESHOLD / DITHER
+#==============================================================================
+
+def to_pixels(rows, threshold, dither, invert):
+    """rows of (grey, alpha) -> rows of 0/1 (1 = LED on)"""
+    # Ink level per pixel: 0 (off) to 255 (on)
+    levels = []
+    for row in rows:
+        line = []
+        for grey, alpha in row:
+            ink = grey if invert else 255 - grey
+            line.append(ink * alpha / 255.0)
+        levels.append(line)
+
+    cut = 255 - threshold
+    if not dither:
+        return [[1 if v > cut else 0 for v in line] for line in levels]
+
+    # Floyd-Steinberg error diffusion
+    height, width = len(levels), len(levels[0]) if levels else 0
+    pixels = [[0] * width for _ in range(height)]
+    for y in range(height):
+        for x in range(width):
+            old = levels[y][x]
+            on = 1 if old > cut else 0
+            pixels[y][x] = on
+            err = old - (255 if on else 0)
+            for dx, dy, w in ((1, 0, 7), (-1, 1, 3), (0, 1, 5), (1, 1, 1)):
+                if 0 <= x + dx < width and y + dy < height:
+                    levels[y + dy][x + dx] += err * w / 16.0
+    return pixels
+
+
+#==============================================================================
+# ENCODERS
+#==============================================================================
+
+def encode_raw(pixels, width):
+    out = bytearray()
+    for row in pixels:
+        for bx in range(0, width, 8):
+            byte = 0
+            for bit in range(8):
+                if bx + bit < width and row[bx + bit]:
+                    byte |= 0x80 >> bit
+            out.append(byte)
+    return out
+
+
+def encode_rle(data):
+    """Runs of 3+ equal bytes become (125 + count, byte), the rest literal blocks"""
+    out = bytearray()
+    literal = bytearray()
+
+    def flush():
+        while literal:
+            block = literal[:128]
+            out.append(len(block) - 1)
+            out.extend(block)
+            del literal[:128]
+
+    i = 0
+    while i < len(data):
+        run = 1
+        while i + run < len(data) and data[i + run] == data[i] and run < 130:
+            run += 1
+        if run >= 3:
+            flush()
+            out.append(125 + run)
+            out.append(data[i])
+            i += run
+        else:
+            literal.append(data[i])
+            i += 1
+    flush()
+    return out
+
+
+def decode_rle(data):
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        n = data[i]
+        if n >= 128:
+            out.extend(bytes([data[i + 1]]) * (n - 125))
+            i += 2
+        else:
+            out.extend(data[i + 1:i + 2 + n])
+            i += 2 + n
+    return out
+
+
+def remap_row(y):
+    """vma419_remap_row(): logical -> physical row (rows 16+ stay as they are)"""
+    physical = (y // 4) * 4 + (3, 0, 1, 2)[y % 4]
+    return physical if physical < PANEL_HEIGHT else y
+
+
+def encode_wire(pixels, width, height):
+    """Frame buffer layout of vma419_set_pixel(), sent in scan order"""
+    if width % PANEL_WIDTH or height % PANEL_HEIGHT:
+        raise ValueError("wire format needs a multiple of %dx%d pixels (one or more whole panels)"
+                         % (PANEL_WIDTH, PANEL_HEIGHT))
+    wide, high = width // PANEL_WIDTH, height // PANEL_HEIGHT
+    total = wide * high
+    frame = bytearray(total * PANEL_WIDTH * PANEL_HEIGHT // 8)
+
+    for y in range(height):
+        physical = remap_row(y)
+        for x in range(width):
+            if not pixels[y][x]:
+                continue
+            panel = x // PANEL_WIDTH + wide * (physical // PANEL_HEIGHT)
+            bx = x % PANEL_WIDTH + panel * PANEL_WIDTH
+            index = bx // 8 + (physical % PANEL_HEIGHT) * (total * 4)
+            if index < len(frame):
+                frame[index] |= 0x80 >> (bx % 8)
+
+    out = bytearray()
+    rowsize = total * 4
+    for cycle in range(4):
+        offset = rowsize * cycle
+        for _ in range(total):
+            for column, k in WIRE_ORDER:
+                out.append(frame[offset + column + k * total * 16])
+            offset += 4
+    return out
+
+
+#==============================================================================
+# OUTPUT
+#==============================================================================
+
+def header_bytes(fmt, width, height):
+    return bytes([fmt, width & 0xFF, width >> 8, height])
+
+
+def write_header(path, name, fmt, width, height, payload, pixels, source):
+    data = header_bytes(fmt, width, height) + payload
+    guard = re.sub(r"\W", "_", os.path.basename(path)).upper()
+    upper = name.upper()
+
+    lines = [
+        "/*",
+        " * %s - %s, %dx%d pixels" % (os.path.basename(path), name, width, height),
+        " *",
+        " * Generated by tools/bitmap_compile.py from %s, do not edit." % os.path.basename(source),
+        " * Format %s, %d bytes of flash (4 of them header). Draw it with" % (FORMAT_NAMES[fmt], len(data)),
+        " *   vma419_draw_bitmap_P(&display, x, y, %s);" % name,
+        " *",
+    ]
+    for row in pixels:
+        lines.append(" *   " + "".join("#" if p else "." for p in row))
+    lines += [
+        " */",
+        "",
+        "#ifndef %s" % guard,
+        "#define %s" % guard,
+        "",
+        "#include <stdint.h>",
+        "#include <avr/pgmspace.h>",
+        "",
+        "#define %s_WIDTH  %d" % (upper, width),
+        "#define %s_HEIGHT %d" % (upper, height),
+        "",
+        "const uint8_t %s[] PROGMEM = {" % name,
+    ]
+    lines.append("    %d, %d, %d, %d,  // %s, width %d, height %d"
+                 % (data[0], data[1], data[2], data[3], FORMAT_NAMES[fmt], width, height))
+    for i in range(4, len(data), 12):
+        lines.append("    " + " ".join("0x%02x," % b for b in data[i:i + 12]))
+    lines += ["};", "", "#endif // %s" % guard, ""]
+
+    with open(path, "w") as f:
+        f.write("\n".join(lines))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Convert an image into a PROGMEM bitmap for vma419_draw_bitmap_P()")
+    parser.add_argument("image", help="PBM, PGM or PNG file")
+    parser.add_argument("-o", "--output", help="header file to write (default: print sizes only)")
+    parser.add_argument("--name", help="array name (default: from the output file name)")
+    parser.add_argument("--format", choices=("auto", "raw", "wire", "rle"), default="auto")
+    parser.add_argument("--threshold", type=int, default=128, help="grey level 0-255 that splits on/off")
+    parser.add_argument("--dither", action="store_true", help="Floyd-Steinberg dithering instead of a hard threshold")
+    parser.add_argument("--invert", action="store_true", help="light pixels are on (for white-on-black images)")
+    parser.add_argument("--preview", action="store_true", help="print the result as text")
+    args = parser.parse_args()
+
+    try:
+        width, height, rows = read_image(args.image)
+        if width > 2040 or height > 255:
+            raise ValueError("at most 2040x255 pixels")
+        pixels = to_pixels(rows, args.threshold, args.dither, args.invert)
+
+        raw = encode_raw(pixels, width)
+        rle = encode_rle(raw)
+        assert decode_rle(rle) == raw
+        if args.format == "wire":
+            fmt, payload = FORMAT_WIRE, encode_wire(pixels, width, height)
+        elif args.format == "rle" or (args.format == "auto" and len(rle) < len(raw)):
+            fmt, payload = FORMAT_RLE, rle
+        else:
+            fmt, payload = FORMAT_RAW, raw
+    except (OSError, ValueError, KeyError, zlib.error) as e:
+        print("%s: %s" % (args.image, e), file=sys.stderr)
+        return 2
+
+    if args.preview:
+        for row in pixels:
+            print("".join("#" if p else "." for p in row))
+    print("%dx%d: raw %d bytes, rle %d bytes -> %s, %d bytes with header"
+          % (width, height, len(raw), len(rle), FORMAT_NAMES[fmt], len(payload) + 4))
+
+    if args.output:
+        name = args.name or re.sub(r"\W", "_", os.path.splitext(os.path.basename(args.output))[0])
+        write_header(args.output, name, fmt, width, height, payload, pixels, args.image)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,181 @@
+#!/usr/bin/env python3
+"""
+cycle_bench.py - Cycles-per-call regression gate for the display hot paths
+
+What this tool does:
+- Runs the benchmark firmware (bench/cycle_bench.elf) in simavr, or reads
+  "BENCH <name> <cycles>" lines captured from a board's serial output
+- Compares every result with tools/cycle_bench_baseline.json
+- Prints the cycles per function with the change against the baseline
+- With --check, fails if any function got slower by more than the threshold
+
+Functions measured (see bench/cycle_bench.c):
+- clear, set_pixel          : vma419_clear(), one vma419_set_pixel()
+- draw_string(_clipped)     : the main loop's text, at x=0 and half scrolled out
+- draw_text_rowfont         : the same text with vma419_draw_text_P() (row font)
+- draw_string_arial14       : the same text in Arial_14 (VMA419_FontCreator.h)
+- logo                      : fesb_logo_display()
+- scan_phase, scan_frame    : one / four vma419_scan_display_quarter() calls;
+                              the report also shows how much of scan_phase is
+                              the SPI burst, from the cycle-exact timing model
+- scroll_step               : clear + draw + 4 phases, as one main loop pass
+
+At 8 MHz one scan phase is 8000 cycles (1 ms). A scroll_step that grows
+towards that eats into the time the LEDs are lit, which shows up as flicker.
+
+Usage:
+  python3 tools/cycle_bench.py                      # Run simavr, print the report
+  python3 tools/cycle_bench.py --check              # Exit 1 if anything got slower
+  python3 tools/cycle_bench.py --update-baseline    # Accept current numbers
+  python3 tools/cycle_bench.py --results serial.log # Use captured output instead
+"""
+
+import argparse
+import json
+import os
+import re
+import subprocess
+import sys
+
+DEFAULT_ELF = "bench/cycle_bench.elf"
+DEFAULT_BASELINE = os.path.join(os.path.dirname(os.path.abspath(__file__)), "cycle_bench_baseline.json")
+DEFAULT_SIMAVR = "simavr"
+
+BENCH_LINE = re.compile(r"BENCH (\w+) (\d+)")
+FRAME_BUDGET = 8000                 # Cycles in one 1 ms scan phase at 8 MHz
+
+# Scan burst timing model, must match VMA419_SCAN_* in vma419.h
+SCAN_SLOT_CYCLES = 18               # Cycles per SPI byte (fosc/2 + 2 spare)
+SCAN_BYTES_PER_PANEL = 16
+SCAN_BURST_SETUP_CYCLES = 4
+BENCH_PANELS = 1                    # bench/cycle_bench.c drives one panel
+
+
+def scan_burst_cycles(panels):
+    """Cycles the SPI burst of one scan phase takes (VMA419_SCAN_BURST_CYCLES)"""
+    return SCAN_BURST_SETUP_CYCLES + panels * SCAN_BYTES_PER_PANEL * SCAN_SLOT_CYCLES
+
+
+def parse_results(text):
+    """'BENCH name cycles' lines -> {name: cycles}; raises if 'BENCH done' is missing"""
+    results = {}
+    done = False
+    for line in text.splitlines():
+        if "BENCH done" in line:
+            done = True
+            break
+        if "BENCH error" in line:
+            raise RuntimeError(line.strip())
+        m = BENCH_LINE.search(line)
+        if m:
+            results[m.group(1)] = int(m.group(2))
+    if not done:
+        raise RuntimeError("benchmark output ended before 'BENCH done'")
+    return results
+
+
+def run_simavr(simavr, elf, timeout):
+    """Run the benchmark firmware and return everything it printed"""
+    cmd = [simavr, "-m", "atmega16", "-f", "8000000", elf]
+    try:
+        proc = subprocess.run(cmd, stdout=subprocess.PIPE, stderr=subprocess.STDOUT,
+                              timeout=timeout, universal_newlines=True)
+        return proc.stdout
+    except FileNotFoundError:
+        raise RuntimeError("%s not found (install simavr or use --results)" % simavr)
+    except subprocess.TimeoutExpired as e:
+        # simavr normally exits when the firmware sleeps with interrupts off;
+        # whatever was printed until the timeout is still usable
+        out = e.stdout or ""
+        return out.decode(errors="replace") if isinstance(out, bytes) else out
+
+
+def print_report(results, baseline, threshold):
+    """Print the table and return the list of functions that got slower"""
+    slower = []
+    names = sorted(set(results) | set(baseline))
+
+    print("%-20s %10s %10s %10s %8s" % ("Function", "Baseline", "Cycles", "Delta", "Delta%"))
+    print("-" * 62)
+    for name in names:
+        now = results.get(name)
+        base = baseline.get(name)
+        flag = ""
+        if now is None:
+            print("%-20s %10d %10s %10s %8s  <-- MISSING" % (name, base, "-", "-", "-"))
+            slower.append(name)
+            continue
+        if base is None:
+            print("%-20s %10s %10d %10s %8s  <-- NEW" % (name, "-", now, "new", "-"))
+            continue
+
+        delta = now - base
+        percent = 100.0 * delta / base if base else 0.0
+        if percent > threshold:
+            flag = "  <-- SLOWER"
+            slower.append(name)
+        elif percent < -threshold:
+            flag = "  (faster)"
+        print("%-20s %10d %10d %+10d %+7.1f%%%s" % (name, base, now, delta, percent, flag))
+
+    print("-" * 62)
+    if "scan_phase" in results:
+        burst = scan_burst_cycles(BENCH_PANELS)
+        print("scan_phase: %d cycles SPI burst (model), %d cycles select/latch/call overhead"
+              % (burst, results["scan_phase"] - burst))
+    if "scroll_step" in results:
+        print("scroll_step uses %.1f%% of one %d-cycle scan phase"
+              % (100.0 * results["scroll_step"] / FRAME_BUDGET, FRAME_BUDGET))
+    return slower
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Cycles-per-call regression gate for the display hot paths")
+    parser.add_argument("elf", nargs="?", default=DEFAULT_ELF, help="benchmark firmware")
+    parser.add_argument("--results", help="read BENCH lines from this file ('-' = stdin) instead of running simavr")
+    parser.add_argument("--simavr", default=DEFAULT_SIMAVR, help="simavr executable")
+    parser.add_argument("--timeout", type=float, default=60, help="seconds to let simavr run")
+    parser.add_argument("--baseline", default=DEFAULT_BASELINE, help="baseline JSON file")
+    parser.add_argument("--threshold", type=float, default=2.0, help="percent slowdown allowed per function")
+    parser.add_argument("--check", action="store_true", help="exit with status 1 if any function got slower")
+    parser.add_argument("--update-baseline", action="store_true", help="write current numbers as the new baseline")
+    args = parser.parse_args()
+
+    if args.results == "-":
+        text = sys.stdin.read()
+    elif args.results:
+        with open(args.results, errors="replace") as f:
+            text = f.read()
+
+    try:
+        if not args.results:
+            text = run_simavr(args.simavr, args.elf, args.timeout)
+        results = parse_results(text)
+    except RuntimeError as e:
+        print("Benchmark failed: %s" % e, file=sys.stderr)
+        return 2
+
+    if args.update_baseline:
+        with open(args.baseline, "w") as f:
+            json.dump(results, f, indent=2, sort_keys=True)
+            f.write("\n")
+        print("Baseline written to %s" % args.baseline)
+
+    baseline = {}
+    if os.path.exists(args.baseline):
+        with open(args.baseline) as f:
+            baseline = json.load(f)
+    elif args.check:
+        print("No baseline at %s, create it with --update-baseline" % args.baseline, file=sys.stderr)
+        return 2
+
+    slower = print_report(results, baseline, args.threshold)
+    if slower:
+        print("\nSlower than baseline (> %.1f%%): %s" % (args.threshold, ", ".join(slower)))
+        if args.check:
+            return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
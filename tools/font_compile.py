@@ -0,0 +1,370 @@
+#!/usr/bin/env python3
+"""
+font_compile.py - Turn a font into a row font for vma419_draw_text_P()
+
+What this tool does:
+- Reads a BDF font, VMA419_Font.h, or a FontCreator font (Cpp_Lib/DMD419/*.h)
+- Stores every glyph row by row, MSB = leftmost pixel: the same layout as
+  the frame buffer, so drawing a glyph row is one or two byte writes
+  instead of transposing column bytes one bit at a time
+- Writes a C header with one PROGMEM array: header, width table, offset
+  table and glyph data (layout in vma419.h, "ROW FONTS")
+- Can keep only the characters a program really uses (subsetting)
+
+Input formats (--input-format, default: guessed from the file):
+- bdf          STARTCHAR/BITMAP glyphs; the cell is FONT_ASCENT + FONT_DESCENT
+               high and each glyph is as wide as its DWIDTH
+- vma419       VMA419_Font.h: fixed width, one byte per column, bit 0 = top
+- fontcreator  FontCreator arrays (DMD419 fonts): fixed or variable width,
+               columns of (height+7)/8 bytes, the last byte bottom aligned
+
+Subsetting (characters outside the subset get width 0 and no data):
+  --chars "0123456789:"        exactly these characters
+  --chars-from FILE            every character in a text file
+  --strings-from FILE.c        every character in the C string literals of a file
+The tables only span the first to the last character kept.
+
+Usage:
+  python3 tools/font_compile.py VMA419_Font.h -o font5x7_rows.h
+  python3 tools/font_compile.py Cpp_Lib/DMD419/Arial14.h --strings-from main.c -o arial14_rows.h
+  python3 tools/font_compile.py clock.bdf --chars "0123456789:" --name clock_digits -o clock.h
+"""
+
+import argparse
+import os
+import re
+import sys
+
+
+#==============================================================================
+# FONT READERS (all return a Font: height, spacing, {code: Glyph})
+#==============================================================================
+
+class Glyph:
+    def __init__(self, width, rows):
+        self.width = width
+        self.rows = rows            # height lists of 0/1, each width long
+
+
+class Font:
+    def __init__(self, height, spacing, glyphs):
+        self.height = height
+        self.spacing = spacing
+        self.glyphs = glyphs
+
+
+def c_array_values(text):
+    """Numbers in the first PROGMEM array of a C file"""
+    text = re.sub(r"/\*.*?\*/", "", text, flags=re.S)
+    text = re.sub(r"//[^\n]*", "", text)
+    m = re.search(r"PROGMEM\s*=\s*\{(.*?)\}", text, re.S)
+    if not m:
+        raise ValueError("no PROGMEM array found")
+    return [int(v, 0) for v in re.findall(r"0[xX][0-9a-fA-F]+|\d+", m.group(1))]
+
+
+def c_define(text, suffix):
+    m = re.search(r"#define\s+\w*%s\s+(\d+)" % suffix, text)
+    if not m:
+        raise ValueError("no #define ..%s found" % suffix)
+    return int(m.group(1))
+
+
+def read_vma419(text):
+    """VMA419_Font.h: WIDTH columns per glyph, bit 0 = top row"""
+    width = c_define(text, "_FONT_WIDTH")
+    height = c_define(text, "_FONT_HEIGHT")
+    first = c_define(text, "_FIRST_CHAR")
+    data = c_array_values(text)
+
+    glyphs = {}
+    for i in range(len(data) // width):
+        columns = data[i * width:(i + 1) * width]
+        rows = [[(columns[x] >> y) & 1 for x in range(width)] for y in range(height)]
+        glyphs[first + i] = Glyph(width, rows)
+    return Font(height, 1, glyphs)
+
+
+def read_fontcreator(text):
+    """FontCreator: size(2), width, height, first, count, [widths], column data"""
+    data = c_array_values(text)
+    size = (data[0] << 8) | data[1]
+    fixed_width, height, first, count = data[2], data[3], data[4], data[5]
+    bytes_per_column = (height + 7) // 8
+
+    if size == 0:
+        widths = [fixed_width] * count
+        pos = 6
+    else:
+        widths = data[6:6 + count]
+        pos = 6 + count
+
+    glyphs = {}
+    for i, width in enumerate(widths):
+        rows = [[0] * width for _ in range(height)]
+        for b in range(bytes_per_column):
+            # The last byte holds the bottom 8 rows, overlapping the one before
+            top = height - 8 if (b == bytes_per_column - 1 and bytes_per_column > 1) else b * 8
+            for x in range(width):
+                column = data[pos + b * width + x]
+                for bit in range(8):
+                    if top + bit < height and (column >> bit) & 1:
+                        rows[top + bit][x] = 1
+        pos += width * bytes_per_column
+        glyphs[first + i] = Glyph(width, rows)
+
+    # Space is often left out (width 0); DMD419 uses the width of 'n' then
+    if not glyphs.get(32) or glyphs[32].width == 0:
+        width = glyphs[ord("n")].width if ord("n") in glyphs else fixed_width
+        glyphs[32] = Glyph(width, [[0] * width for _ in range(height)])
+    return Font(height, 1, glyphs)
+
+
+def read_bdf(text):
+    ascent = descent = None
+    glyphs = {}
+    lines = iter(text.splitlines())
+    for line in lines:
+        words = line.split()
+        if not words:
+            continue
+        if words[0] == "FONT_ASCENT":
+            ascent = int(words[1])
+        elif words[0] == "FONT_DESCENT":
+            descent = int(words[1])
+        elif words[0] == "FONTBOUNDINGBOX" and ascent is None:
+            ascent, descent = int(words[2]) + int(words[4]), -int(words[4])
+        elif words[0] == "STARTCHAR":
+            code, advance, bbx, bitmap = None, 0, (0, 0, 0, 0), []
+            for line in lines:
+                words = line.split()
+                if not words:
+                    continue
+                if words[0] == "ENCODING":
+                    code = int(words[1])
+                elif words[0] == "DWIDTH":
+                    advance = int(words[1])
+                elif words[0] == "BBX":
+                    bbx = tuple(int(w) for w in words[1:5])
+                elif words[0] == "BITMAP":
+                    for line in lines:
+                        if line.strip() == "ENDCHAR":
+                            break
+                        bitmap.append(int(line.strip(), 16) if line.strip() else 0)
+                    break
+            if code is None or code < 0 or code > 255 or ascent is None:
+                continue
+            w, h, xoff, yoff = bbx
+            height = ascent + descent
+            width = max(advance, w + xoff)
+            rows = [[0] * width for _ in range(height)]
+            bits = ((w + 7) // 8) * 8
+            for r, value in enumerate(bitmap):
+                y = ascent - (h + yoff) + r
+                for c in range(w):
+                    x = xoff + c
+                    if 0 <= y < height and 0 <= x < width and (value >> (bits - 1 - c)) & 1:
+                        rows[y][x] = 1
+            glyphs[code] = Glyph(width, rows)
+    if ascent is None:
+        raise ValueError("no FONT_ASCENT/FONTBOUNDINGBOX in BDF file")
+    # DWIDTH already holds the gap between glyphs
+    return Font(ascent + descent, 0, glyphs)
+
+
+def read_font(path, kind):
+    with open(path, errors="replace") as f:
+        text = f.read()
+    if kind == "auto":
+        if "STARTFONT" in text[:100]:
+            kind = "bdf"
+        elif re.search(r"#define\s+\w*_FIRST_CHAR", text):
+            kind = "vma419"
+        else:
+            kind = "fontcreator"
+    return {"bdf": read_bdf, "vma419": read_vma419, "fontcreator": read_fontcreator}[kind](text)
+
+
+#==============================================================================
+# SUBSETTING
+#==============================================================================
+
+def c_string_chars(text):
+    """Characters used in the string literals of C source"""
+    text = re.sub(r"/\*.*?\*/", "", text, flags=re.S)
+    text = re.sub(r"//[^\n]*", "", text)
+    used = set()
+    for literal in re.findall(r'"((?:[^"\\\n]|\\.)*)"', text):
+        literal = re.sub(r"\\(x[0-9a-fA-F]{1,2}|[0-7]{1,3}|.)", lambda m: escape(m.group(1)), literal)
+        used.update(literal)
+    return used
+
+
+def escape(code):
+    simple = {"n": "\n", "r": "\r", "t": "\t", "0": "\0", "\\": "\\", '"': '"', "'": "'"}
+    if code in simple:
+        return simple[code]
+    if code[0] == "x":
+        return chr(int(code[1:], 16))
+    if code[0].isdigit():
+        return chr(int(code, 8))
+    return code
+
+
+def subset(font, keep):
+    """Glyphs not in keep (a set of codes) are dropped"""
+    font.glyphs = {code: g for code, g in font.glyphs.items() if code in keep}
+    return font
+
+
+#==============================================================================
+# OUTPUT
+#==============================================================================
+
+def glyph_bytes(glyph):
+    out = []
+    for row in glyph.rows:
+        for bx in range(0, glyph.width, 8):
+            byte = 0
+            for bit in range(8):
+                if bx + bit < glyph.width and row[bx + bit]:
+                    byte |= 0x80 >> bit
+            out.append(byte)
+    return out
+
+
+def char_name(code):
+    if code == 39:
+        return "'\\''"
+    if code == 92:
+        return "'\\\\'"
+    if 32 < code < 127:
+        return "'%c'" % code
+    return "0x%02X" % code
+
+
+def compile_font(font):
+    """-> (first, count, widths, offsets, [(code, bytes)])"""
+    codes = sorted(c for c, g in font.glyphs.items() if g.width > 0)
+    if not codes:
+        raise ValueError("no glyphs left")
+    first, last = codes[0], codes[-1]
+    count = last - first + 1
+    widths, offsets, blocks = [], [], []
+    offset = 0
+    for code in range(first, last + 1):
+        glyph = font.glyphs.get(code)
+        if glyph is None or glyph.width == 0:
+            widths.append(0)
+            offsets.append(0)
+            continue
+        if glyph.width > 255:
+            raise ValueError("glyph %s is wider than 255 pixels" % char_name(code))
+        data = glyph_bytes(glyph)
+        widths.append(glyph.width)
+        offsets.append(offset)
+        blocks.append((code, data))
+        offset += len(data)
+    if offset > 0xFFFF:
+        raise ValueError("more than 64 KB of glyph data")
+    return first, count, widths, offsets, blocks
+
+
+def write_header(path, name, font, source):
+    first, count, widths, offsets, blocks = compile_font(font)
+    total = 4 + 3 * count + sum(len(b) for _, b in blocks)
+    guard = re.sub(r"\W", "_", os.path.basename(path)).upper()
+    upper = name.upper()
+    bytes_per_row = lambda w: (w + 7) // 8
+
+    lines = [
+        "/*",
+        " * %s - %s, row font for vma419_draw_text_P()" % (os.path.basename(path), name),
+        " *",
+        " * Generated by tools/font_compile.py from %s, do not edit." % os.path.basename(source),
+        " * %d pixels high, %d glyphs, %d bytes of flash." % (font.height, len(blocks), total),
+        " *",
+        " */",
+        "",
+        "#ifndef %s" % guard,
+        "#define %s" % guard,
+        "",
+        "#include <stdint.h>",
+        "#include <avr/pgmspace.h>",
+        "",
+        "#define %s_HEIGHT     %d" % (upper, font.height),
+        "#define %s_FIRST_CHAR %d" % (upper, first),
+        "#define %s_CHAR_COUNT %d" % (upper, count),
+        "",
+        "const uint8_t %s[] PROGMEM = {" % name,
+        "    %d, %d, %d, %d,  // height, first char, char count, spacing" % (font.height, first, count, font.spacing),
+        "",
+        "    // widths",
+    ]
+    for i in range(0, count, 12):
+        lines.append("    " + " ".join("%d," % w for w in widths[i:i + 12]))
+    lines += ["", "    // offsets (low, high)"]
+    for i in range(0, count, 6):
+        lines.append("    " + " ".join("0x%02x, 0x%02x," % (o & 0xFF, o >> 8) for o in offsets[i:i + 6]))
+
+    for code, data in blocks:
+        width = font.glyphs[code].width
+        step = bytes_per_row(width)
+        lines += ["", "    // %s, %d px" % (char_name(code), width)]
+        for r in range(font.height):
+            row = data[r * step:(r + 1) * step]
+            picture = "".join("#" if p else "." for p in font.glyphs[code].rows[r])
+            lines.append("    %-24s // %s" % (" ".join("0x%02x," % b for b in row), picture))
+    lines += ["};", "", "#endif // %s" % guard, ""]
+
+    with open(path, "w") as f:
+        f.write("\n".join(lines))
+    return total
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Convert a font into a row font for vma419_draw_text_P()")
+    parser.add_argument("font", help="BDF file, VMA419_Font.h or a FontCreator header")
+    parser.add_argument("-o", "--output", help="header file to write (default: print sizes only)")
+    parser.add_argument("--name", help="array name (default: from the output file name)")
+    parser.add_argument("--input-format", choices=("auto", "bdf", "vma419", "fontcreator"), default="auto")
+    parser.add_argument("--spacing", type=int, help="pixels between glyphs (default: 1, BDF: 0)")
+    parser.add_argument("--chars", help="keep only these characters")
+    parser.add_argument("--chars-from", help="keep only the characters in this text file")
+    parser.add_argument("--strings-from", action="append", default=[],
+                        help="keep only the characters in the string literals of this C file (repeatable)")
+    args = parser.parse_args()
+
+    try:
+        font = read_font(args.font, args.input_format)
+        keep = set()
+        if args.chars is not None:
+            keep |= {ord(c) for c in args.chars}
+        if args.chars_from:
+            with open(args.chars_from, encoding="latin-1") as f:
+                keep |= {ord(c) for c in f.read()}
+        for path in args.strings_from:
+            with open(path, encoding="latin-1") as f:
+                keep |= {ord(c) for c in c_string_chars(f.read())}
+        if args.chars is not None or args.chars_from or args.strings_from:
+            font = subset(font, keep)
+        if args.spacing is not None:
+            font.spacing = args.spacing
+
+        first, count, widths, offsets, blocks = compile_font(font)
+    except (OSError, ValueError, IndexError) as e:
+        print("%s: %s" % (args.font, e), file=sys.stderr)
+        return 2
+
+    data = sum(len(b) for _, b in blocks)
+    print("%d px high, %d glyphs (%s to %s): %d bytes glyph data + %d bytes tables"
+          % (font.height, len(blocks), char_name(first), char_name(first + count - 1), data, 4 + 3 * count))
+
+    if args.output:
+        name = args.name or re.sub(r"\W", "_", os.path.splitext(os.path.basename(args.output))[0])
+        write_header(args.output, name, font, args.font)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
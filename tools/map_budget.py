@@ -0,0 +1,279 @@
+#!/usr/bin/env python3
+"""
+map_budget.py - Flash/SRAM budget report from the avr-ld linker map
+
+What this tool does:
+- Reads the linker map written by every MPLAB X build
+  (dist/default/production/Final_Project.X.production.map)
+- Adds up how many bytes of flash and SRAM each part of the firmware uses
+- Compares the result with a checked-in baseline and flags anything that grew
+
+Modules reported:
+- main.o, vma419.o      : code and variables of each object file
+- fonts                 : font tables (VMA419_Font.h and any DMD419 fonts)
+- logo                  : the FESB logo bitmap
+- strings               : string literals (these live in SRAM on AVR!)
+- libc / startup        : avr-libc, libgcc and the C runtime startup code
+
+Flash counts .text (code + PROGMEM tables) plus the .data load image.
+SRAM counts .data + .bss + .noinit. Heap and stack are not in the map.
+
+The baseline also records a hash of the firmware sources (.c/.h next to
+main.c) and of the map it was taken from. If the map is still that same
+file but the sources have changed, nobody rebuilt it, and --check and
+--update-baseline refuse it (pass --allow-stale on purpose). File times
+cannot tell this: a git checkout gives every file a fresh time. `make
+budget` rebuilds from clean first, so its map always matches the sources.
+
+Usage:
+  python3 tools/map_budget.py                      # Print the report
+  python3 tools/map_budget.py --check              # Exit 1 if anything grew
+  python3 tools/map_budget.py --update-baseline    # Accept current sizes
+"""
+
+import argparse
+import hashlib
+import json
+import os
+import re
+import sys
+
+DEFAULT_MAP = "dist/default/production/Final_Project.X.production.map"
+DEFAULT_BASELINE = os.path.join(os.path.dirname(os.path.abspath(__file__)), "map_budget_baseline.json")
+
+# Output sections and which memory they occupy
+FLASH_SECTIONS = (".text",)
+SRAM_SECTIONS = (".bss", ".noinit")
+BOTH_SECTIONS = (".data",)          # Stored in flash, copied to SRAM at startup
+
+# Symbol name patterns that get their own budget line (checked in order)
+SYMBOL_GROUPS = [
+    ("fonts", re.compile(r"font|Arial|System5x7", re.IGNORECASE)),
+    ("logo", re.compile(r"logo", re.IGNORECASE)),
+]
+
+SECTION_LINE = re.compile(r"^(\.\w+)\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)")
+INPUT_FULL = re.compile(r"^ (\S+)\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(.+)$")
+INPUT_NAME_ONLY = re.compile(r"^ (\.\S+)$")
+INPUT_CONT = re.compile(r"^\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(.+)$")
+COMMON_ALLOC = re.compile(r"^(\S+)\s+0x([0-9a-fA-F]+)\s+(\S.*)$")
+MEMORY_LINE = re.compile(r"^(text|data)\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)")
+
+
+def module_of(path):
+    """Turn an object/archive path from the map into a short module name"""
+    path = path.strip().replace("\\", "/")
+    if "libc.a" in path or "libgcc.a" in path or "libm.a" in path:
+        return "libc"
+    if path.startswith("linker stubs") or "crt" in os.path.basename(path):
+        return "startup"
+    return os.path.basename(path)
+
+
+def group_of(section_name, symbol, path):
+    """Decide which budget line an input section belongs to"""
+    if ".str1." in section_name or re.search(r"\.rodata\..*\.str", section_name):
+        return "strings"
+    for group, pattern in SYMBOL_GROUPS:
+        if symbol and pattern.search(symbol):
+            return group
+    return module_of(path)
+
+
+def parse_map(text):
+    """
+    Parse a GNU ld map file
+    @return (usage, limits) where usage is {group: {"flash": n, "sram": n}}
+            and limits is {"flash": n, "sram": n} from the memory configuration
+    """
+    usage = {}
+    limits = {}
+    common_sizes = {}   # COMMON symbols: name -> (size, path)
+
+    def add(group, flash, sram):
+        entry = usage.setdefault(group, {"flash": 0, "sram": 0})
+        entry["flash"] += flash
+        entry["sram"] += sram
+
+    lines = text.splitlines()
+    output_section = None
+    in_common_table = False
+    pending_name = None
+    pending_common = None   # (path, remaining size) while listing COMMON symbols
+
+    for line in lines:
+        if line.startswith("Allocating common symbols"):
+            in_common_table = True
+            continue
+        if in_common_table:
+            if line.startswith("Discarded input sections"):
+                in_common_table = False
+            else:
+                m = COMMON_ALLOC.match(line)
+                if m and m.group(1) != "Common":
+                    common_sizes[m.group(1)] = int(m.group(2), 16)
+            continue
+
+        m = MEMORY_LINE.match(line)
+        if m:
+            limits["flash" if m.group(1) == "text" else "sram"] = int(m.group(3), 16)
+            continue
+
+        m = SECTION_LINE.match(line)
+        if m:
+            output_section = m.group(1)
+            pending_name = None
+            pending_common = None
+            continue
+        if line and not line[0].isspace():
+            output_section = None   # Some output section we do not budget
+            continue
+
+        if output_section not in FLASH_SECTIONS + SRAM_SECTIONS + BOTH_SECTIONS:
+            continue
+
+        # Input section on one line, or a name line followed by the numbers
+        name = size = path = None
+        m = INPUT_FULL.match(line)
+        if m and not m.group(1).startswith("*"):
+            name, size, path = m.group(1), int(m.group(3), 16), m.group(4)
+        else:
+            m = INPUT_NAME_ONLY.match(line)
+            if m:
+                pending_name = m.group(1)
+                continue
+            m = INPUT_CONT.match(line)
+            if m and pending_name:
+                name, size, path = pending_name, int(m.group(2), 16), m.group(3)
+                pending_name = None
+            elif pending_common and re.match(r"^\s+0x[0-9a-fA-F]+\s+(\w+)$", line):
+                # Symbol inside a COMMON block: move its bytes to its group
+                symbol = line.split()[-1]
+                if symbol in common_sizes:
+                    common_path, _ = pending_common
+                    group = group_of("COMMON", symbol, common_path)
+                    if group != module_of(common_path):
+                        add(module_of(common_path), 0, -common_sizes[symbol])
+                        add(group, 0, common_sizes[symbol])
+                continue
+            else:
+                continue
+
+        if size == 0 or path.startswith("0x"):
+            continue
+
+        symbol = name.split(".")[-1] if name.count(".") >= 2 else None
+        group = group_of(name, symbol, path)
+        if output_section in FLASH_SECTIONS:
+            add(group, size, 0)
+        elif output_section in SRAM_SECTIONS:
+            add(group, 0, size)
+        else:
+            add(group, size, size)
+
+        pending_common = (path, size) if name == "COMMON" else None
+
+    return usage, limits
+
+
+def print_report(usage, limits, baseline, threshold):
+    """Print the budget table and return the list of groups that grew"""
+    grown = []
+    names = sorted(set(usage) | set(baseline), key=lambda g: (-usage.get(g, {}).get("flash", 0), g))
+
+    print("%-14s %8s %8s   %10s %10s" % ("Module", "Flash", "SRAM", "dFlash", "dSRAM"))
+    print("-" * 56)
+    total = {"flash": 0, "sram": 0}
+    for group in names:
+        now = usage.get(group, {"flash": 0, "sram": 0})
+        base = baseline.get(group)
+        total["flash"] += now["flash"]
+        total["sram"] += now["sram"]
+
+        if base is None:
+            delta = ("new", "new")
+            flag = "  <-- NEW"
+            grown.append(group)
+        else:
+            d_flash = now["flash"] - base["flash"]
+            d_sram = now["sram"] - base["sram"]
+            delta = ("%+d" % d_flash, "%+d" % d_sram)
+            flag = ""
+            if d_flash > threshold or d_sram > threshold:
+                flag = "  <-- GREW"
+                grown.append(group)
+        print("%-14s %8d %8d   %10s %10s%s" % (group, now["flash"], now["sram"], delta[0], delta[1], flag))
+
+    print("-" * 56)
+    line = "%-14s %8d %8d" % ("TOTAL", total["flash"], total["sram"])
+    if limits:
+        line += "   (%.1f%% of %d flash, %.1f%% of %d SRAM before heap/stack)" % (
+            100.0 * total["flash"] / limits.get("flash", 1), limits.get("flash", 0),
+            100.0 * total["sram"] / limits.get("sram", 1), limits.get("sram", 0))
+    print(line)
+    return grown
+
+
+def sources_hash(root):
+    """SHA-256 over the names and contents of the firmware sources (.c/.h next to main.c)"""
+    digest = hashlib.sha256()
+    for name in sorted(os.listdir(root)):
+        if name.endswith((".c", ".h")):
+            with open(os.path.join(root, name), "rb") as f:
+                data = f.read().replace(b"\r\n", b"\n")    # Same hash for either line ending
+            digest.update(name.encode() + b"\0" + data + b"\0")
+    return digest.hexdigest()
+
+
+def file_hash(path):
+    with open(path, "rb") as f:
+        return hashlib.sha256(f.read()).hexdigest()
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Flash/SRAM budget report from the linker map")
+    parser.add_argument("map", nargs="?", default=DEFAULT_MAP, help="linker map file")
+    parser.add_argument("--baseline", default=DEFAULT_BASELINE, help="baseline JSON file")
+    parser.add_argument("--threshold", type=int, default=0, help="bytes of growth allowed per module")
+    parser.add_argument("--check", action="store_true", help="exit with status 1 if any module grew")
+    parser.add_argument("--update-baseline", action="store_true", help="write current sizes as the new baseline")
+    parser.add_argument("--allow-stale", action="store_true", help="use a map that was not rebuilt for the current sources anyway")
+    parser.add_argument("--sources", default=".", help="directory with main.c and the driver (for the rebuild check)")
+    args = parser.parse_args()
+
+    baseline = {}
+    if os.path.exists(args.baseline):
+        with open(args.baseline) as f:
+            baseline = json.load(f)
+    build = baseline.pop("_build", {})
+    map_sha = file_hash(args.map)
+    src_sha = sources_hash(args.sources)
+
+    # The very map the baseline came from, but other sources: it was not rebuilt
+    if build.get("map_sha256") == map_sha and build.get("sources_sha256") != src_sha:
+        print("warning: %s is the map of the baseline build, but the sources in %s have changed "
+              "since; rebuild before trusting these numbers" % (args.map, args.sources), file=sys.stderr)
+        if (args.check or args.update_baseline) and not args.allow_stale:
+            return 2
+
+    with open(args.map, encoding="utf-8", errors="replace") as f:
+        usage, limits = parse_map(f.read())
+
+    if args.update_baseline:
+        baseline = dict(usage)
+        with open(args.baseline, "w") as f:
+            json.dump(dict(usage, _build={"map_sha256": map_sha, "sources_sha256": src_sha}),
+                      f, indent=2, sort_keys=True)
+            f.write("\n")
+        print("Baseline written to %s" % args.baseline)
+
+    grown = print_report(usage, limits, baseline, args.threshold)
+    if grown:
+        print("\nGrowth against baseline: %s" % ", ".join(grown))
+        if args.check:
+            return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,357 @@
+#!/usr/bin/env python3
+"""
+scan_decode.py - Rebuild the picture a VMA419 panel shows from its input signals
+
+What this tool does:
+- Reads a recording of the display connector: every byte shifted in over SPI
+  plus the A/B row select, latch and OE pins
+- Plays it into a model of the panel hardware (shift registers, latch,
+  row select, output enable)
+- Writes the picture the LEDs would show as ASCII art, PGM or PNG frames
+
+The panel model is written from the wire format, not from vma419.c, so it
+checks the byte order in vma419_scan_display_quarter() and the A/B mapping:
+- Per panel and scan phase, 16 bytes go out in this order (c = byte column
+  0-3, k = row 0-3 of the 4 rows lit together):
+  (c0,k3) (c0,k2) (c1,k3) (c1,k2) (c0,k1) (c0,k0) (c1,k1) (c1,k0)
+  (c2,k3) (c2,k2) (c3,k3) (c3,k2) (c2,k1) (c2,k0) (c3,k1) (c3,k0)
+  Inside a byte the first bit shifted (MSB) is the leftmost LED, 1 = on
+- Row select s (A = bit 0, B = bit 1) lights panel rows r, r+4, r+8, r+12
+  with r = (s + 1) % 4 (this is why vma419_set_pixel() remaps rows)
+- The first panel's 16 bytes of a latch belong to the top left panel, then
+  left to right and top to bottom. --chain places them anywhere instead:
+  one COLUMN,ROW[,ORIENT] per panel in that order, ORIENT = 1 mirrored left
+  to right, 2 top to bottom, 3 mounted upside down (as VMA419_ChainTile and
+  vma419_set_chain_P() in vma419.h)
+
+Inputs:
+- host_hal traces ("<time_us> <signal> <hex>", see host/host_hal.h), for
+  example from host/scan_record
+- VCD files (for example from simavr). A VCD only records changes, so two
+  equal bytes in a row (blank columns, dark rows) leave one SPI entry; a
+  byte is counted on each --strobe instead: the rising edge of SIGNAL:BIT
+  (e.g. SPSR:7 = SPIF, or SCK edges divided out by the simulator), or every
+  entry of a SIGNAL without a bit (a per-byte SPDR write event). It takes
+  the SPI value of its own time step. host/scan_record --vcd writes one.
+
+Signals are named SIGNAL or SIGNAL:BIT. The defaults match main.c:
+SPI data SPDR, A = PORTA:1, B = PORTA:2, latch = PORTA:4, OE = PORTD:7
+(active low, as in vma419.c).
+
+Usage:
+  python3 tools/scan_decode.py scan.trace --ascii
+  python3 tools/scan_decode.py scan.trace -o frame_%03d.png --scale 8
+  python3 tools/scan_decode.py sim.vcd --strobe SPSR:7 --ascii
+  python3 tools/scan_decode.py sim.vcd --spi spi_byte --strobe spi_write --latch LAT --oe OE --ascii
+  python3 tools/scan_decode.py wall.trace --wide 2 --high 2 --chain "0,0 1,0 1,1,3 0,1,3" --ascii
+"""
+
+import argparse
+import re
+import struct
+import sys
+import zlib
+
+PANEL_WIDTH = 32
+PANEL_HEIGHT = 16
+BYTES_PER_PHASE = 16
+
+# (byte column, row index k) of each of the 16 bytes of one panel and phase
+WIRE_ORDER = [
+    (0, 3), (0, 2), (1, 3), (1, 2), (0, 1), (0, 0), (1, 1), (1, 0),
+    (2, 3), (2, 2), (3, 3), (3, 2), (2, 1), (2, 0), (3, 1), (3, 0),
+]
+
+
+def parse_signal(spec):
+    """'PORTA:1' -> ('PORTA', 1), 'LATCH' -> ('LATCH', None)"""
+    if ":" in spec:
+        name, bit = spec.rsplit(":", 1)
+        return name, int(bit)
+    return spec, None
+
+
+#==============================================================================
+# INPUT FORMATS
+#==============================================================================
+
+def read_trace(lines):
+    """host_hal trace -> list of (time, signal, value)"""
+    events = []
+    for number, line in enumerate(lines, 1):
+        line = line.strip()
+        if not line or line.startswith("#"):
+            continue
+        parts = line.split()
+        if len(parts) != 3:
+            raise ValueError("line %d: expected '<time> <signal> <hex>'" % number)
+        events.append((int(parts[0]), parts[1], int(parts[2], 16)))
+    return events
+
+
+VCD_VAR = re.compile(r"\$var\s+\S+\s+\d+\s+(\S+)\s+(\S+)")
+
+
+def read_vcd(text):
+    """VCD file -> list of (time, signal, value); x/z bits read as 0"""
+    ids = {}
+    events = []
+    header, _, body = text.partition("$enddefinitions")
+    for match in VCD_VAR.finditer(header):
+        ids.setdefault(match.group(1), []).append(match.group(2))
+
+    time = 0
+    tokens = iter(body.split())
+    next(tokens, None)                  # the "$end" closing $enddefinitions
+    for token in tokens:
+        if token.startswith("#"):
+            time = int(token[1:])
+        elif token.startswith("$"):
+            continue                    # $dumpvars, $end, ...
+        elif token[0] in "bB":
+            bits = token[1:].translate(str.maketrans("xXzZ", "0000"))
+            ident = next(tokens, "")
+            for name in ids.get(ident, ()):
+                events.append((time, name, int(bits, 2)))
+        elif token[0] in "01xXzZ" and len(token) > 1:
+            value = 1 if token[0] == "1" else 0
+            for name in ids.get(token[1:], ()):
+                events.append((time, name, value))
+    return events
+
+
+def strobe_bytes(events, spi, strobe):
+    """VCD events -> the same events with one SPI byte per strobe instead of per SPI change"""
+    name, bit = strobe
+    result = []
+    spi_value = 0
+    level = 0
+    step = None
+    strobes = 0                         # strobes in the current time step
+    for time, signal, value in events + [(None, None, 0)]:
+        if time != step:
+            # the whole step is read, so the SPI value is the one of this step
+            result.extend([(step, spi, spi_value)] * strobes)
+            step = time
+            strobes = 0
+        if signal == spi:
+            spi_value = value
+        elif signal is not None:
+            result.append((time, signal, value))
+        if signal == name:
+            if bit is None:
+                strobes += 1
+            else:
+                strobes += ((value >> bit) & 1) and not level
+                level = (value >> bit) & 1
+    return result
+
+
+#==============================================================================
+# PANEL MODEL
+#==============================================================================
+
+class PanelChain:
+    """Shift registers, latch, row select and output enable of a panel chain"""
+
+    def __init__(self, wide, high, oe_active_low, tiles=None):
+        self.wide = wide
+        self.high = high
+        self.panels = wide * high
+        # (column, row, orientation) of every panel in chain order
+        self.tiles = tiles or [(p % wide, p // wide, 0) for p in range(self.panels)]
+        self.oe_active_low = oe_active_low
+        self.shifted = []
+        self.latched = None
+        self.image = [[0] * (wide * PANEL_WIDTH) for _ in range(high * PANEL_HEIGHT)]
+        self.shown = set()              # row selects shown since the last frame
+        self.frames = []
+        self.short_latches = 0
+
+    def shift(self, byte):
+        self.shifted.append(byte)
+        del self.shifted[:-self.panels * BYTES_PER_PHASE]
+
+    def latch(self):
+        need = self.panels * BYTES_PER_PHASE
+        if len(self.shifted) < need:
+            self.short_latches += 1
+        self.latched = ([0] * need + self.shifted)[-need:]
+
+    def show(self, select):
+        """OE is active: the latched data lights the rows of this select"""
+        if self.latched is None:
+            return
+        if select in self.shown:
+            self.end_frame()
+        self.shown.add(select)
+
+        first_row = (select + 1) % 4
+        for panel, (tile_column, tile_row, orientation) in enumerate(self.tiles):
+            x0 = tile_column * PANEL_WIDTH
+            y0 = tile_row * PANEL_HEIGHT
+            data = self.latched[panel * BYTES_PER_PHASE:(panel + 1) * BYTES_PER_PHASE]
+            for byte, (column, k) in zip(data, WIRE_ORDER):
+                y = first_row + 4 * k
+                if orientation & 2:
+                    y = PANEL_HEIGHT - 1 - y
+                row = self.image[y0 + y]
+                for bit in range(8):
+                    x = column * 8 + bit
+                    if orientation & 1:
+                        x = PANEL_WIDTH - 1 - x
+                    row[x0 + x] = (byte >> (7 - bit)) & 1
+
+    def end_frame(self):
+        if self.shown:
+            self.frames.append([row[:] for row in self.image])
+            self.shown = set()
+
+
+def parse_chain(text, wide, high):
+    """'COLUMN,ROW[,ORIENT] ...' -> [(column, row, orientation)] in chain order"""
+    tiles = []
+    for item in text.replace(";", " ").split():
+        numbers = [int(n) for n in item.split(",")]
+        if len(numbers) == 2:
+            numbers.append(0)
+        if len(numbers) != 3 or not (0 <= numbers[0] < wide and 0 <= numbers[1] < high and 0 <= numbers[2] <= 3):
+            raise ValueError("bad --chain tile %r" % item)
+        tiles.append(tuple(numbers))
+    if len(tiles) != wide * high or len(set(t[:2] for t in tiles)) != len(tiles):
+        raise ValueError("--chain needs every one of the %d tiles once" % (wide * high))
+    return tiles
+
+
+def decode(events, args):
+    spi = args.spi
+    a, b, latch, oe = (parse_signal(s) for s in (args.a, args.b, args.latch, args.oe))
+    chain = PanelChain(args.wide, args.high, args.oe_active == "low", args.chain)
+
+    values = {}
+
+    def pin(signal):
+        name, bit = signal
+        value = values.get(name, 0)
+        return value & 1 if bit is None else (value >> bit) & 1
+
+    def oe_on():
+        return pin(oe) == (0 if chain.oe_active_low else 1)
+
+    for _, name, value in events:
+        if name == spi:
+            chain.shift(value & 0xFF)
+            continue
+        before = (pin(a) | pin(b) << 1, pin(latch), oe_on())
+        values[name] = value
+        select, latch_pin, enabled = pin(a) | pin(b) << 1, pin(latch), oe_on()
+
+        if latch_pin and not before[1]:
+            chain.latch()
+        if enabled and (not before[2] or select != before[0] or (latch_pin and not before[1])):
+            chain.show(select)
+
+    chain.end_frame()
+    if chain.short_latches:
+        print("warning: %d latch pulse(s) with fewer than %d bytes shifted in"
+              % (chain.short_latches, chain.panels * BYTES_PER_PHASE), file=sys.stderr)
+    return chain.frames
+
+
+#==============================================================================
+# OUTPUT
+#==============================================================================
+
+def scaled(frame, scale):
+    rows = []
+    for row in frame:
+        line = [255 if on else 0 for on in row for _ in range(scale)]
+        rows.extend([line] * scale)
+    return rows
+
+
+def write_pgm(path, frame, scale):
+    rows = scaled(frame, scale)
+    with open(path, "wb") as f:
+        f.write(b"P5\n%d %d\n255\n" % (len(rows[0]), len(rows)))
+        for line in rows:
+            f.write(bytes(line))
+
+
+def write_png(path, frame, scale):
+    rows = scaled(frame, scale)
+
+    def chunk(kind, data):
+        body = kind + data
+        return struct.pack(">I", len(data)) + body + struct.pack(">I", zlib.crc32(body) & 0xFFFFFFFF)
+
+    raw = b"".join(b"\x00" + bytes(line) for line in rows)
+    header = struct.pack(">IIBBBBB", len(rows[0]), len(rows), 8, 0, 0, 0, 0)
+    with open(path, "wb") as f:
+        f.write(b"\x89PNG\r\n\x1a\n")
+        f.write(chunk(b"IHDR", header))
+        f.write(chunk(b"IDAT", zlib.compress(raw)))
+        f.write(chunk(b"IEND", b""))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Rebuild VMA419 panel images from recorded scan signals")
+    parser.add_argument("input", help="host_hal trace or .vcd file ('-' for a trace on stdin)")
+    parser.add_argument("--wide", type=int, default=1, help="panels side by side")
+    parser.add_argument("--high", type=int, default=1, help="panels stacked")
+    parser.add_argument("--chain", help="tile of every panel in chain order: 'COLUMN,ROW[,ORIENT] ...'")
+    parser.add_argument("--spi", default="SPDR", help="signal carrying the shifted bytes")
+    parser.add_argument("--strobe", help="VCD only: one byte per rising edge of SIGNAL:BIT, or per entry of SIGNAL")
+    parser.add_argument("--a", default="PORTA:1", help="row select A")
+    parser.add_argument("--b", default="PORTA:2", help="row select B")
+    parser.add_argument("--latch", default="PORTA:4", help="latch clock")
+    parser.add_argument("--oe", default="PORTD:7", help="output enable")
+    parser.add_argument("--oe-active", choices=("low", "high"), default="low", help="OE level that lights the LEDs")
+    parser.add_argument("--ascii", action="store_true", help="print every frame as text")
+    parser.add_argument("--last", action="store_true", help="only output the last frame")
+    parser.add_argument("-o", "--output", help="output file pattern, e.g. frame_%%03d.png or .pgm")
+    parser.add_argument("--scale", type=int, default=1, help="image pixels per LED")
+    args = parser.parse_args()
+    if args.chain:
+        try:
+            args.chain = parse_chain(args.chain, args.wide, args.high)
+        except ValueError as e:
+            parser.error(str(e))
+
+    if args.input == "-":
+        events = read_trace(sys.stdin)
+    else:
+        with open(args.input) as f:
+            text = f.read()
+        if args.input.endswith(".vcd"):
+            if not args.strobe:
+                parser.error("a VCD needs --strobe: equal bytes in a row leave no SPI value change")
+            events = strobe_bytes(read_vcd(text), args.spi, parse_signal(args.strobe))
+        else:
+            events = read_trace(text.splitlines())
+
+    frames = decode(events, args)
+    if not frames:
+        print("No complete scan found (no latch with OE active)", file=sys.stderr)
+        return 1
+    if args.last:
+        frames = frames[-1:]
+
+    for index, frame in enumerate(frames):
+        if args.ascii:
+            print("frame %d" % index)
+            for row in frame:
+                print("".join("#" if on else "." for on in row))
+        if args.output:
+            path = args.output % index if "%" in args.output else args.output
+            if path.lower().endswith(".png"):
+                write_png(path, frame, args.scale)
+            else:
+                write_pgm(path, frame, args.scale)
+    if not args.ascii:
+        print("%d frame(s) decoded" % len(frames))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,143 @@
+/*
+ * utf8_latin1.h - UTF-8 Input for the ISO-8859-1 (Latin-1) Fonts
+ *
+ * Serial terminals send accented letters as UTF-8 (2 to 4 bytes each),
+ * while Arial_Black_16_ISO_8859_1 has one glyph per Latin-1 code (0-255).
+ * A finished message is converted once, when main.c takes it from the
+ * UART, so drawing and measuring keep working on one byte per character.
+ *
+ * How characters are mapped:
+ * - U+0020..U+007E and U+00A1..U+00FF are Latin-1 already (same number)
+ * - U+00A0 (no-break space) becomes a space; the font has no glyph for it
+ * - Letters of other Latin alphabets (Croatian, Polish, Czech, Hungarian,
+ *   Romanian, Turkish, ...) and typographic quotes/dashes come from a small
+ *   PROGMEM table: the same letter without the accent or the closest
+ *   Latin-1 letter (ő -> ö, Đ -> Ð)
+ * - Everything else, and broken UTF-8, becomes '?'
+ *
+ * Usage:
+ *   #include "utf8_latin1.h"
+ *   utf8_to_latin1(text, received, sizeof(text));   // once per message
+ *   latin1_send_utf8(USART_Transmit, text);         // to echo it back
+ *
+ */
+
+#ifndef UTF8_LATIN1_H
+#define UTF8_LATIN1_H
+
+#include <avr/pgmspace.h>
+#include <stdint.h>
+
+#define LATIN1_UNKNOWN '?'          // Shown for characters the font cannot show
+
+typedef struct {
+    uint16_t code_point;
+    uint8_t latin1;
+} Latin1Substitute;
+
+// Sorted by code point
+static const Latin1Substitute latin1_substitutes[] PROGMEM = {
+    {0x0102, 'A'}, {0x0103, 'a'}, {0x0104, 'A'}, {0x0105, 'a'},     // Ă ă Ą ą
+    {0x0106, 'C'}, {0x0107, 'c'}, {0x010C, 'C'}, {0x010D, 'c'},     // Ć ć Č č
+    {0x010E, 'D'}, {0x010F, 'd'}, {0x0110, 0xD0}, {0x0111, 'd'},    // Ď ď Đ đ
+    {0x0118, 'E'}, {0x0119, 'e'}, {0x011A, 'E'}, {0x011B, 'e'},     // Ę ę Ě ě
+    {0x011E, 'G'}, {0x011F, 'g'}, {0x0130, 'I'}, {0x0131, 'i'},     // Ğ ğ İ ı
+    {0x0141, 'L'}, {0x0142, 'l'}, {0x0143, 'N'}, {0x0144, 'n'},     // Ł ł Ń ń
+    {0x0147, 'N'}, {0x0148, 'n'}, {0x0150, 0xD6}, {0x0151, 0xF6},   // Ň ň Ő ő
+    {0x0152, 'O'}, {0x0153, 'o'}, {0x0158, 'R'}, {0x0159, 'r'},     // Œ œ Ř ř
+    {0x015A, 'S'}, {0x015B, 's'}, {0x015E, 'S'}, {0x015F, 's'},     // Ś ś Ş ş
+    {0x0160, 'S'}, {0x0161, 's'}, {0x0162, 'T'}, {0x0163, 't'},     // Š š Ţ ţ
+    {0x0164, 'T'}, {0x0165, 't'}, {0x016E, 'U'}, {0x016F, 'u'},     // Ť ť Ů ů
+    {0x0170, 0xDC}, {0x0171, 0xFC}, {0x0178, 'Y'}, {0x0179, 'Z'},   // Ű ű Ÿ Ź
+    {0x017A, 'z'}, {0x017B, 'Z'}, {0x017C, 'z'}, {0x017D, 'Z'},     // ź Ż ż Ž
+    {0x017E, 'z'}, {0x0218, 'S'}, {0x0219, 's'}, {0x021A, 'T'},     // ž Ș ș Ț
+    {0x021B, 't'}, {0x2013, '-'}, {0x2014, '-'}, {0x2018, '\''},    // ț – — ‘
+    {0x2019, '\''}, {0x201C, '"'}, {0x201D, '"'}, {0x201E, '"'},    // ’ “ ” „
+    {0x2022, 0xB7}, {0x2026, '.'}, {0x20AC, 'E'}                    // • … €
+};
+
+#define LATIN1_SUBSTITUTE_COUNT (sizeof(latin1_substitutes) / sizeof(latin1_substitutes[0]))
+
+/**
+ * Latin-1 code (font glyph) for a Unicode code point
+ * @return 32-126 or 161-255, LATIN1_UNKNOWN if there is no good match
+ */
+static inline uint8_t latin1_from_code_point(uint32_t code_point) {
+    if (code_point >= 0x20 && code_point <= 0x7E) return (uint8_t)code_point;
+    if (code_point == 0xA0) return ' ';
+    if (code_point > 0xA0 && code_point <= 0xFF) return (uint8_t)code_point;
+
+    for (uint8_t i = 0; i < LATIN1_SUBSTITUTE_COUNT; i++) {
+        uint16_t entry = pgm_read_word(&latin1_substitutes[i].code_point);
+        if (entry == code_point) return pgm_read_byte(&latin1_substitutes[i].latin1);
+        if (entry > code_point) break;
+    }
+    return LATIN1_UNKNOWN;
+}
+
+/**
+ * Convert a UTF-8 string to Latin-1, one byte per character
+ *
+ * A lead byte without all of its continuation bytes, a stray continuation
+ * byte and an invalid lead byte each give one LATIN1_UNKNOWN; the byte that
+ * broke a sequence is read again as the start of the next character.
+ *
+ * @param dst Output buffer (may be the same as src: the output is never longer)
+ * @param src Null-terminated UTF-8 string
+ * @param size Size of dst including the terminator
+ * @return Length of the converted string
+ */
+static inline uint8_t utf8_to_latin1(char* dst, const char* src, uint8_t size) {
+    const uint8_t* s = (const uint8_t*)src;
+    uint8_t length = 0;
+
+    while (*s && length < size - 1) {
+        uint8_t lead = *s++;
+        uint8_t more;
+        uint32_t code_point;
+
+        if (lead < 0x80) {
+            dst[length++] = (lead >= 0x20 && lead <= 0x7E) ? (char)lead : LATIN1_UNKNOWN;
+            continue;
+        } else if (lead >= 0xC2 && lead <= 0xDF) {
+            more = 1;
+            code_point = lead & 0x1F;
+        } else if (lead >= 0xE0 && lead <= 0xEF) {
+            more = 2;
+            code_point = lead & 0x0F;
+        } else if (lead >= 0xF0 && lead <= 0xF4) {
+            more = 3;
+            code_point = lead & 0x07;
+        } else {
+            dst[length++] = LATIN1_UNKNOWN;     // Continuation byte or invalid lead byte
+            continue;
+        }
+
+        while (more > 0 && (*s & 0xC0) == 0x80) {
+            code_point = (code_point << 6) | (*s++ & 0x3F);
+            more--;
+        }
+        dst[length++] = more ? LATIN1_UNKNOWN : (char)latin1_from_code_point(code_point);
+    }
+    dst[length] = '\0';
+    return length;
+}
+
+/**
+ * Send a Latin-1 string as UTF-8 (for echoing converted text to a terminal)
+ * @param put Sends one byte (USART_Transmit)
+ * @param text Null-terminated Latin-1 string
+ */
+static inline void latin1_send_utf8(void (*put)(char), const char* text) {
+    while (*text) {
+        uint8_t c = (uint8_t)*text++;
+        if (c < 0x80) {
+            put((char)c);
+        } else {
+            put((char)(0xC0 | (c >> 6)));
+            put((char)(0x80 | (c & 0x3F)));
+        }
+    }
+}
+
+#endif // UTF8_LATIN1_H
@@ -28,6 +28,7 @@
 #include <stdlib.h> 
 #include <string.h> 
 #include <util/delay.h>
+#include <avr/pgmspace.h>
 
 // ===============================================
 // HELPER MACROS FOR PIN CONTROL
@@ -36,6 +37,51 @@
 #define PIN_SET_HIGH(port_reg, pin_mask)   (*(port_reg) |= (pin_mask))
 #define PIN_SET_LOW(port_reg, pin_mask)    (*(port_reg) &= ~(pin_mask))
 
+// ===============================================
+// LIT LED COUNTING AND OE TIMING
+// ===============================================
+
+// LEDs lit by each value of a 4-bit nibble
+static const uint8_t vma419_popcount_nibble[16] PROGMEM = {
+    0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4
+};
+
+static uint8_t vma419_popcount(uint8_t byte) {
+    return pgm_read_byte(&vma419_popcount_nibble[byte & 0x0F]) +
+           pgm_read_byte(&vma419_popcount_nibble[byte >> 4]);
+}
+
+/**
+ * Keep phase_lit[] right after a frame buffer byte changed
+ * A byte of physical row y (within its panel) is sent in scan phase y % 4.
+ */
+static void vma419_lit_changed(VMA419_Display* disp, uint8_t physical_y, uint8_t old_byte, uint8_t new_byte) {
+    if (old_byte != new_byte) {
+        disp->phase_lit[physical_y & 0x03] += vma419_popcount(new_byte) - vma419_popcount(old_byte);
+    }
+}
+
+// The OE pin vma419_oe_pulse_end() switches off (one display with timed OE at a time).
+// The driver leaves TIMER2_COMP_vect to the application: see VMA419_OE_TIMER2_ISR().
+volatile uint8_t* vma419_oe_port;
+uint8_t vma419_oe_mask;
+
+/**
+ * On-time of one phase in Timer2 ticks, from how many of its LEDs are lit
+ * (the curve is interpolated between its points, 1/16 of the phase apart)
+ */
+static uint8_t vma419_phase_on_ticks(const VMA419_Display* disp, uint8_t phase) {
+    uint16_t share = (disp->phase_lit[phase] * disp->lit_scale) >> 7;   // 0-256
+    uint8_t point = share >> 4;
+    uint8_t scale = disp->oe_curve[point];
+
+    if (point < VMA419_OE_CURVE_POINTS - 1) {
+        int16_t step = (int16_t)disp->oe_curve[point + 1] - scale;
+        scale += (step * (share & 0x0F)) >> 4;
+    }
+    return ((uint16_t)scale * disp->oe_on_ticks + 255) >> 8;
+}
+
 // ===============================================
 // HARDWARE SPI FUNCTIONS
 // ===============================================
@@ -53,31 +99,269 @@ static void spi_init(void) {
            (1 << MSTR) |    // Master mode
            (0 << CPOL) |    // Clock polarity: idle low
            (0 << CPHA) |    // Clock phase: sample on leading edge
-           (0 << SPR1) |    // SPI Speed: fosc/4 (fastest)
+           (0 << SPR1) |    // SPI Speed: fosc/4...
            (0 << SPR0);
     
-    // Standard SPI timing (no double speed)
-    SPSR &= ~(1 << SPI2X);
+    // ...doubled to fosc/2 (4 MHz): one byte every 16 cycles, which the
+    // scan burst below is timed against (VMA419_SCAN_SLOT_CYCLES)
+    SPSR |= (1 << SPI2X);
     
     // Set SS pin high (not used but good practice)
     PORTB |= (1 << PB4);
 }
 
-/**
- * Send one byte via hardware SPI to the VMA419 display
- * Uses ATmega16 SPI peripheral for fast data transmission
- * 
- * @param data Byte to transmit (MSB first)
+/*
+ * Send the 16 bytes of every panel for one scan phase (the SPI burst)
+ *
+ * Per panel the bytes come from 4 rows in this order (row, byte column):
+ *   r3.0 r2.0 r3.1 r2.1 r1.0 r0.0 r1.1 r0.1 r3.2 r2.2 r3.3 r2.3 r1.2 r0.2 r1.3 r0.3
+ * Every row is read front to back, so two pointers are enough: "high"
+ * walks rows 3 and 2, "low" rows 1 and 0, each stepping down one row
+ * (row_step bytes) and then back up to the next byte of the row above.
+ * After 16 bytes both already point at the next panel.
+ *
+ * @param row1 Frame buffer byte 0 of row 1 (of 0-3) of this phase, first panel
+ * @param row_step Bytes between the 4 rows of one phase (16 per panel),
+ *                 negative to send the rows bottom up (vma419_set_orientation)
+ * @param panels Number of panels (1 or more)
+ *
+ * vma419_scan_output_reversed() sends one panel mirrored left to right:
+ * the same walk from byte 3 of each row down to byte 0, every byte through
+ * vma419_bit_reverse[] so its leftmost pixel goes out last.
  */
-static void spi_transfer(uint8_t data) {
-    // Hardware SPI transfer
-    SPDR = data;                        // Load data into SPI Data Register
-    while (!(SPSR & (1 << SPIF)));      // Wait for transmission complete
-    // Reading SPSR and SPDR clears the SPIF flag automatically
-    volatile uint8_t dummy = SPDR;      // Clear SPIF by reading SPDR
-    (void)dummy;                        // Suppress unused variable warning
+
+// Every byte with its bits in the opposite order (256-byte aligned, so the
+// AVR only sets the low byte of Z to look one up)
+static const uint8_t vma419_bit_reverse[256] PROGMEM __attribute__((aligned(256))) = {
+    0x00, 0x80, 0x40, 0xC0, 0x20, 0xA0, 0x60, 0xE0, 0x10, 0x90, 0x50, 0xD0, 0x30, 0xB0, 0x70, 0xF0,
+    0x08, 0x88, 0x48, 0xC8, 0x28, 0xA8, 0x68, 0xE8, 0x18, 0x98, 0x58, 0xD8, 0x38, 0xB8, 0x78, 0xF8,
+    0x04, 0x84, 0x44, 0xC4, 0x24, 0xA4, 0x64, 0xE4, 0x14, 0x94, 0x54, 0xD4, 0x34, 0xB4, 0x74, 0xF4,
+    0x0C, 0x8C, 0x4C, 0xCC, 0x2C, 0xAC, 0x6C, 0xEC, 0x1C, 0x9C, 0x5C, 0xDC, 0x3C, 0xBC, 0x7C, 0xFC,
+    0x02, 0x82, 0x42, 0xC2, 0x22, 0xA2, 0x62, 0xE2, 0x12, 0x92, 0x52, 0xD2, 0x32, 0xB2, 0x72, 0xF2,
+    0x0A, 0x8A, 0x4A, 0xCA, 0x2A, 0xAA, 0x6A, 0xEA, 0x1A, 0x9A, 0x5A, 0xDA, 0x3A, 0xBA, 0x7A, 0xFA,
+    0x06, 0x86, 0x46, 0xC6, 0x26, 0xA6, 0x66, 0xE6, 0x16, 0x96, 0x56, 0xD6, 0x36, 0xB6, 0x76, 0xF6,
+    0x0E, 0x8E, 0x4E, 0xCE, 0x2E, 0xAE, 0x6E, 0xEE, 0x1E, 0x9E, 0x5E, 0xDE, 0x3E, 0xBE, 0x7E, 0xFE,
+    0x01, 0x81, 0x41, 0xC1, 0x21, 0xA1, 0x61, 0xE1, 0x11, 0x91, 0x51, 0xD1, 0x31, 0xB1, 0x71, 0xF1,
+    0x09, 0x89, 0x49, 0xC9, 0x29, 0xA9, 0x69, 0xE9, 0x19, 0x99, 0x59, 0xD9, 0x39, 0xB9, 0x79, 0xF9,
+    0x05, 0x85, 0x45, 0xC5, 0x25, 0xA5, 0x65, 0xE5, 0x15, 0x95, 0x55, 0xD5, 0x35, 0xB5, 0x75, 0xF5,
+    0x0D, 0x8D, 0x4D, 0xCD, 0x2D, 0xAD, 0x6D, 0xED, 0x1D, 0x9D, 0x5D, 0xDD, 0x3D, 0xBD, 0x7D, 0xFD,
+    0x03, 0x83, 0x43, 0xC3, 0x23, 0xA3, 0x63, 0xE3, 0x13, 0x93, 0x53, 0xD3, 0x33, 0xB3, 0x73, 0xF3,
+    0x0B, 0x8B, 0x4B, 0xCB, 0x2B, 0xAB, 0x6B, 0xEB, 0x1B, 0x9B, 0x5B, 0xDB, 0x3B, 0xBB, 0x7B, 0xFB,
+    0x07, 0x87, 0x47, 0xC7, 0x27, 0xA7, 0x67, 0xE7, 0x17, 0x97, 0x57, 0xD7, 0x37, 0xB7, 0x77, 0xF7,
+    0x0F, 0x8F, 0x4F, 0xCF, 0x2F, 0xAF, 0x6F, 0xEF, 0x1F, 0x9F, 0x5F, 0xDF, 0x3F, 0xBF, 0x7F, 0xFF
+};
+
+#if defined(__AVR__)
+
+#if VMA419_SCAN_SLOT_CYCLES < VMA419_SPI_CYCLES_PER_BYTE + 1 || VMA419_SCAN_SLOT_CYCLES > 255
+#error "VMA419_SCAN_SLOT_CYCLES must be 17 or more (the SPI needs 16 cycles per byte)"
+#endif
+
+// Waste n cycles in as few words as possible (rjmp .+0 = 2 cycles, 1 word)
+#define VMA419_ASM_PAD(n) \
+    ".rept (" n ") / 2    \n\t" \
+    "rjmp .+0            \n\t" \
+    ".endr               \n\t" \
+    ".if (" n ") & 1     \n\t" \
+    "nop                 \n\t" \
+    ".endif              \n\t"
+
+// One byte slot: start sending 'byte' (1 cycle), load the next byte (2),
+// move the pointer down or up one row (2), pad to VMA419_SCAN_SLOT_CYCLES
+#define VMA419_ASM_SLOT_DOWN(p) \
+    "out %[spdr], %[byte]         \n\t" \
+    "ld  %[byte], %a[" p "]       \n\t" \
+    "sub %A[" p "], %A[step]      \n\t" \
+    "sbc %B[" p "], %B[step]      \n\t" \
+    VMA419_ASM_PAD("%[pad]")
+#define VMA419_ASM_SLOT_UP(p) \
+    "out %[spdr], %[byte]         \n\t" \
+    "ld  %[byte], %a[" p "]+      \n\t" \
+    "add %A[" p "], %A[step]      \n\t" \
+    "adc %B[" p "], %B[step]      \n\t" \
+    VMA419_ASM_PAD("%[pad]")
+
+/*
+ * Cycle-exact and without polling: SPDR is written every
+ * VMA419_SCAN_SLOT_CYCLES cycles, which is never sooner than the previous
+ * byte has left (16 cycles at fosc/2); an interrupt only makes a gap longer.
+ * The last slot of a panel spends 4 of its padding cycles on the loop (the
+ * unrolled body is too long for brne to reach back) and loads the first
+ * byte of the next panel (after the last panel, one byte past it is read
+ * and ignored). Timing model: VMA419_SCAN_BURST_CYCLES() in vma419.h.
+ */
+static void vma419_scan_output(const uint8_t* row1, int16_t row_step, uint8_t panels) {
+    const uint8_t* low = row1;                      // X: rows 1 and 0
+    const uint8_t* high = row1 + 2 * row_step;      // Z: rows 3 and 2
+    uint8_t byte;
+
+    __asm__ volatile (
+        "ld  %[byte], %a[high]        \n\t"       // r3.0 (VMA419_SCAN_BURST_SETUP_CYCLES)
+        "sub %A[high], %A[step]       \n\t"
+        "sbc %B[high], %B[step]       \n\t"
+        "1:                           \n\t"
+        VMA419_ASM_SLOT_UP("high")                  // send r3.0, load r2.0
+        VMA419_ASM_SLOT_DOWN("high")                // send r2.0, load r3.1
+        VMA419_ASM_SLOT_UP("high")                  // send r3.1, load r2.1
+        VMA419_ASM_SLOT_DOWN("low")                 // send r2.1, load r1.0
+        VMA419_ASM_SLOT_UP("low")                   // send r1.0, load r0.0
+        VMA419_ASM_SLOT_DOWN("low")                 // send r0.0, load r1.1
+        VMA419_ASM_SLOT_UP("low")                   // send r1.1, load r0.1
+        VMA419_ASM_SLOT_DOWN("high")                // send r0.1, load r3.2
+        VMA419_ASM_SLOT_UP("high")                  // send r3.2, load r2.2
+        VMA419_ASM_SLOT_DOWN("high")                // send r2.2, load r3.3
+        VMA419_ASM_SLOT_UP("high")                  // send r3.3, load r2.3
+        VMA419_ASM_SLOT_DOWN("low")                 // send r2.3, load r1.2
+        VMA419_ASM_SLOT_UP("low")                   // send r1.2, load r0.2
+        VMA419_ASM_SLOT_DOWN("low")                 // send r0.2, load r1.3
+        VMA419_ASM_SLOT_UP("low")                   // send r1.3, load r0.3
+        "out %[spdr], %[byte]         \n\t"       // send r0.3, load r3.0 of the next panel
+        "ld  %[byte], %a[high]        \n\t"
+        "sub %A[high], %A[step]       \n\t"
+        "sbc %B[high], %B[step]       \n\t"
+        VMA419_ASM_PAD("%[pad_last]")
+        "dec %[panels]                \n\t"       // 1 cycle
+        "breq 2f                      \n\t"       // 1 cycle, 2 at the end...
+        "rjmp 1b                      \n\t"       // 2 cycles
+        "2: nop                       \n\t"       // ...so the last byte is out on return
+        : [byte] "=&r" (byte), [low] "+x" (low), [high] "+z" (high), [panels] "+r" (panels)
+        : [step] "r" (row_step),
+          [spdr] "I" (_SFR_IO_ADDR(SPDR)),
+          [pad] "M" (VMA419_SCAN_SLOT_CYCLES - 5),
+          [pad_last] "M" (VMA419_SCAN_SLOT_CYCLES - 9)
+        : "memory"
+    );
+}
+
+// The same slots through the table: the pointer goes to X (1), the byte to
+// the low byte of Z (2) and its reversed bits come from flash (3)
+#define VMA419_ASM_SLOT_REVERSED(p, add, adc, step) \
+    "out  %[spdr], %[byte]        \n\t" \
+    "movw r26, %[" p "]           \n\t" \
+    "ld   %A[table], X            \n\t" \
+    "lpm  %[byte], Z              \n\t" \
+    add " %A[" p "], %A[" step "] \n\t" \
+    adc " %B[" p "], %B[" step "] \n\t" \
+    VMA419_ASM_PAD("%[pad]")
+#define VMA419_ASM_SLOT_REVERSED_DOWN(p) VMA419_ASM_SLOT_REVERSED(p, "sub", "sbc", "step")
+#define VMA419_ASM_SLOT_REVERSED_UP(p)   VMA419_ASM_SLOT_REVERSED(p, "add", "adc", "step_up")
+
+/*
+ * One panel only; its last slot is padded out so the next call cannot
+ * write SPDR before the last byte has left. Timing model:
+ * VMA419_SCAN_PANEL_CYCLES(VMA419_SCAN_MIRROR_SETUP_CYCLES) in vma419.h.
+ */
+static void vma419_scan_output_reversed(const uint8_t* row1, int16_t row_step) {
+    const uint8_t* low = row1;                      // rows 1 and 0
+    const uint8_t* high = row1 + 2 * row_step;      // rows 3 and 2
+    const uint8_t* table = vma419_bit_reverse;      // Z
+    int16_t step_up = row_step - 1;                 // Up one row and one byte left
+    uint8_t byte;
+
+    __asm__ volatile (
+        "movw r26, %[high]            \n\t"       // r3.3 (VMA419_SCAN_MIRROR_SETUP_CYCLES)
+        "ld   %A[table], X            \n\t"
+        "lpm  %[byte], Z              \n\t"
+        "sub  %A[high], %A[step]      \n\t"
+        "sbc  %B[high], %B[step]      \n\t"
+        VMA419_ASM_SLOT_REVERSED_UP("high")         // send r3.3, load r2.3
+        VMA419_ASM_SLOT_REVERSED_DOWN("high")       // send r2.3, load r3.2
+        VMA419_ASM_SLOT_REVERSED_UP("high")         // send r3.2, load r2.2
+        VMA419_ASM_SLOT_REVERSED_DOWN("low")        // send r2.2, load r1.3
+        VMA419_ASM_SLOT_REVERSED_UP("low")          // send r1.3, load r0.3
+        VMA419_ASM_SLOT_REVERSED_DOWN("low")        // send r0.3, load r1.2
+        VMA419_ASM_SLOT_REVERSED_UP("low")          // send r1.2, load r0.2
+        VMA419_ASM_SLOT_REVERSED_DOWN("high")       // send r0.2, load r3.1
+        VMA419_ASM_SLOT_REVERSED_UP("high")         // send r3.1, load r2.1
+        VMA419_ASM_SLOT_REVERSED_DOWN("high")       // send r2.1, load r3.0
+        VMA419_ASM_SLOT_REVERSED_UP("high")         // send r3.0, load r2.0
+        VMA419_ASM_SLOT_REVERSED_DOWN("low")        // send r2.0, load r1.1
+        VMA419_ASM_SLOT_REVERSED_UP("low")          // send r1.1, load r0.1
+        VMA419_ASM_SLOT_REVERSED_DOWN("low")        // send r0.1, load r1.0
+        VMA419_ASM_SLOT_REVERSED_UP("low")          // send r1.0, load r0.0
+        "out  %[spdr], %[byte]        \n\t"       // send r0.0
+        VMA419_ASM_PAD("%[pad_last]")
+        : [byte] "=&r" (byte), [low] "+r" (low), [high] "+r" (high), [table] "+z" (table)
+        : [step] "r" (row_step), [step_up] "r" (step_up),
+          [spdr] "I" (_SFR_IO_ADDR(SPDR)),
+          [pad] "M" (VMA419_SCAN_SLOT_CYCLES - 9),
+          [pad_last] "M" (VMA419_SCAN_SLOT_CYCLES - 1)
+        : "r26", "r27", "memory"
+    );
+}
+
+#else
+
+// Host build (see host/): same walk in C, waiting for SPIF after every byte
+#define VMA419_SLOT_DOWN(p) \
+    do { SPDR = byte; byte = *(p); (p) -= row_step; while (!(SPSR & (1 << SPIF))); } while (0)
+#define VMA419_SLOT_UP(p) \
+    do { SPDR = byte; byte = *(p)++; (p) += row_step; while (!(SPSR & (1 << SPIF))); } while (0)
+
+static void vma419_scan_output(const uint8_t* row1, int16_t row_step, uint8_t panels) {
+    const uint8_t* low = row1;
+    const uint8_t* high = row1 + 2 * row_step;
+    uint8_t byte = *high;
+    high -= row_step;
+
+    for (;;) {
+        VMA419_SLOT_UP(high);
+        VMA419_SLOT_DOWN(high);
+        VMA419_SLOT_UP(high);
+        VMA419_SLOT_DOWN(low);
+        VMA419_SLOT_UP(low);
+        VMA419_SLOT_DOWN(low);
+        VMA419_SLOT_UP(low);
+        VMA419_SLOT_DOWN(high);
+        VMA419_SLOT_UP(high);
+        VMA419_SLOT_DOWN(high);
+        VMA419_SLOT_UP(high);
+        VMA419_SLOT_DOWN(low);
+        VMA419_SLOT_UP(low);
+        VMA419_SLOT_DOWN(low);
+        VMA419_SLOT_UP(low);
+        SPDR = byte;
+        while (!(SPSR & (1 << SPIF)));
+        if (--panels == 0) break;
+        byte = *high;                               // The next panel (never past the last one here)
+        high -= row_step;
+    }
+}
+
+#define VMA419_SLOT_REVERSED_DOWN(p) \
+    do { SPDR = byte; byte = pgm_read_byte(&vma419_bit_reverse[*(p)]); (p) -= row_step; \
+         while (!(SPSR & (1 << SPIF))); } while (0)
+#define VMA419_SLOT_REVERSED_UP(p) \
+    do { SPDR = byte; byte = pgm_read_byte(&vma419_bit_reverse[*(p)]); (p) += row_step - 1; \
+         while (!(SPSR & (1 << SPIF))); } while (0)
+
+static void vma419_scan_output_reversed(const uint8_t* row1, int16_t row_step) {
+    const uint8_t* low = row1;
+    const uint8_t* high = row1 + 2 * row_step;
+    uint8_t byte = pgm_read_byte(&vma419_bit_reverse[*high]);
+    high -= row_step;
+
+    VMA419_SLOT_REVERSED_UP(high);
+    VMA419_SLOT_REVERSED_DOWN(high);
+    VMA419_SLOT_REVERSED_UP(high);
+    VMA419_SLOT_REVERSED_DOWN(low);
+    VMA419_SLOT_REVERSED_UP(low);
+    VMA419_SLOT_REVERSED_DOWN(low);
+    VMA419_SLOT_REVERSED_UP(low);
+    VMA419_SLOT_REVERSED_DOWN(high);
+    VMA419_SLOT_REVERSED_UP(high);
+    VMA419_SLOT_REVERSED_DOWN(high);
+    VMA419_SLOT_REVERSED_UP(high);
+    VMA419_SLOT_REVERSED_DOWN(low);
+    VMA419_SLOT_REVERSED_UP(low);
+    VMA419_SLOT_REVERSED_DOWN(low);
+    VMA419_SLOT_REVERSED_UP(low);
+    SPDR = byte;
+    while (!(SPSR & (1 << SPIF)));
 }
 
+#endif // __AVR__
+
 
 
 /**
@@ -125,6 +409,15 @@ int vma419_init(VMA419_Display* disp, VMA419_PinConfig* pin_config, uint8_t pane
     PIN_SET_LOW(disp->pins.b_port_out, disp->pins.b_pin_mask);    // Row select B = 0
     PIN_SET_LOW(disp->pins.latch_clk_port_out, disp->pins.latch_clk_pin_mask); // Latch low
 
+    // LEDs per phase (128 per panel) as a multiplier; OE stays on between scans
+    disp->lit_scale = 32768U / (displays_total * (VMA419_RAM_SIZE_BYTES / 4 * 8));
+    disp->oe_on_ticks = 0;
+    memset(disp->oe_curve, 0xFF, sizeof(disp->oe_curve));
+    disp->scan_panels = NULL;       // Sent as drawn (vma419_set_orientation, vma419_set_chain_P)
+    disp->chain = NULL;
+    disp->orientation = VMA419_ORIENT_NORMAL;
+    disp->lit_phase_swap = 0;
+
     // Initialize hardware SPI and clear display
     spi_init();
     vma419_clear(disp);
@@ -141,6 +434,13 @@ int vma419_init(VMA419_Display* disp, VMA419_PinConfig* pin_config, uint8_t pane
  * @param disp Pointer to VMA419 display structure
  */
 void vma419_deinit(VMA419_Display* disp) {
+    if (disp && disp->oe_on_ticks) {
+        vma419_set_oe_timing(disp, 0, 0, 100);  // Give Timer2 back
+    }
+    if (disp && disp->scan_panels) {
+        free(disp->scan_panels);
+        disp->scan_panels = NULL;
+    }
     if (disp && disp->frame_buffer) {
         free(disp->frame_buffer);
         disp->frame_buffer = NULL;
@@ -161,6 +461,7 @@ void vma419_clear(VMA419_Display* disp) {
         // VMA419 uses 1=LED ON, 0=LED OFF
         // So clearing means setting all bits to 0
         memset(disp->frame_buffer, 0x00, disp->frame_buffer_size);
+        memset(disp->phase_lit, 0, sizeof(disp->phase_lit));
     }
 }
 
@@ -171,12 +472,15 @@ void vma419_clear(VMA419_Display* disp) {
  * Logical row 0→3, 1→0, 2→1, 3→2, then repeats for each group of 4 rows
  * This function converts logical row coordinates to physical row coordinates.
  * 
- * @param logical_y Logical row number (0-15)
- * @return Physical row number (0-15)
+ * Groups of 4 never cross a panel, so this works for every panel row of a
+ * wall (rows 16-31 are the second row of panels, and so on).
+ *
+ * @param logical_y Logical row number (0 to total_height_pixels - 1)
+ * @return Physical row number (in the same panel row)
  */
 static uint16_t vma419_remap_row(uint16_t logical_y) {
-    // Group-based remapping for 16-row display
-    uint16_t group = logical_y / 4;  // Which group of 4 rows (0, 1, 2, 3)
+    // Group-based remapping, 4 groups per 16-row panel
+    uint16_t group = logical_y / 4;  // Which group of 4 rows
     uint16_t offset = logical_y % 4; // Position within the group
     
     uint16_t remapped_offset;
@@ -188,14 +492,7 @@ static uint16_t vma419_remap_row(uint16_t logical_y) {
         default: remapped_offset = offset; break;
     }
     
-    uint16_t physical_y = group * 4 + remapped_offset;
-    
-    // Boundary check
-    if (physical_y >= VMA419_PIXELS_DOWN_PER_PANEL) {
-        return logical_y; // Return original if out of bounds
-    }
-    
-    return physical_y;
+    return group * 4 + remapped_offset;
 }
 
 /**
@@ -230,11 +527,13 @@ void vma419_set_pixel(VMA419_Display* disp, uint16_t x, uint16_t y, uint8_t colo
     
     // Set or clear the pixel bit
     if (byte_index < disp->frame_buffer_size) {
+        uint8_t old_byte = disp->frame_buffer[byte_index];
         if (color) { // Pixel ON (VMA419: 1 = LED ON)
             disp->frame_buffer[byte_index] |= bit_mask;
         } else { // Pixel OFF (VMA419: 0 = LED OFF)
             disp->frame_buffer[byte_index] &= ~bit_mask;
         }
+        vma419_lit_changed(disp, bY, old_byte, disp->frame_buffer[byte_index]);
     }
 }
 
@@ -274,6 +573,7 @@ void vma419_write_pixel(VMA419_Display* disp, uint16_t x, uint16_t y, uint8_t gr
     if (ram_pointer >= disp->frame_buffer_size) {
         return;
     }
+    uint8_t old_byte = disp->frame_buffer[ram_pointer];
     
     // Apply graphics mode logic (VMA419: 1=LED ON, 0=LED OFF)
     switch (graphics_mode) {
@@ -317,7 +617,242 @@ void vma419_write_pixel(VMA419_Display* disp, uint16_t x, uint16_t y, uint8_t gr
             }
             break;
     }
-}/**
+    vma419_lit_changed(disp, bY, old_byte, disp->frame_buffer[ram_pointer]);
+}
+
+// ===============================================
+// BITMAPS FROM FLASH
+// ===============================================
+
+/**
+ * Write 8 pixels of a logical row straight into the frame buffer
+ *
+ * The byte is shifted into place when x is not a multiple of 8, so it may
+ * touch two frame buffer bytes. Panels side by side are next to each other
+ * in the frame buffer, so this also works across a panel edge.
+ *
+ * @param disp Pointer to VMA419 display structure
+ * @param x Column of the leftmost pixel (may be negative)
+ * @param y Logical row (must be on screen)
+ * @param value The 8 pixels, MSB = leftmost
+ * @param mask Which of the 8 pixels to write
+ */
+static void vma419_write_byte(VMA419_Display* disp, int16_t x, uint16_t y, uint8_t value, uint8_t mask) {
+    int16_t width = (int16_t)disp->total_width_pixels;
+
+    // Clip at the left and right edge
+    if (x < 0) {
+        if (x <= -8) return;
+        mask &= 0xFF >> (-x);
+    }
+    if (x > width - 8) {
+        if (x >= width) return;
+        mask &= (uint8_t)(0xFF << (x - (width - 8)));
+    }
+    if (!mask) return;
+
+    // Same addressing as vma419_set_pixel(), for column 0 of this row
+    uint16_t physical_y = vma419_remap_row(y);
+    uint16_t displays_total = disp->panels_wide * disp->panels_high;
+    uint8_t* row = disp->frame_buffer
+                 + (physical_y % VMA419_PIXELS_DOWN_PER_PANEL) * (displays_total << 2)
+                 + (physical_y / VMA419_PIXELS_DOWN_PER_PANEL) * (disp->panels_wide << 2);
+
+    int16_t column = x >> 3;                // -1 when x is -7 to -1
+    uint8_t shift = x & 0x07;
+
+    if (column >= 0) {
+        uint8_t m = mask >> shift;
+        uint8_t old_byte = row[column];
+        row[column] = (old_byte & ~m) | ((value >> shift) & m);
+        vma419_lit_changed(disp, physical_y, old_byte, row[column]);
+    }
+    if (shift) {
+        uint8_t m = (uint8_t)(mask << (8 - shift));
+        uint8_t old_byte = row[column + 1];
+        row[column + 1] = (old_byte & ~m) | ((uint8_t)(value << (8 - shift)) & m);
+        vma419_lit_changed(disp, physical_y, old_byte, row[column + 1]);
+    }
+}
+
+/**
+ * Frame buffer position of each byte the scan sends, per panel and phase
+ * (byte column, group of 4 rows), same order as vma419_scan_display_quarter()
+ */
+static const uint8_t vma419_wire_order[16][2] PROGMEM = {
+    {0, 3}, {0, 2}, {1, 3}, {1, 2}, {0, 1}, {0, 0}, {1, 1}, {1, 0},
+    {2, 3}, {2, 2}, {3, 3}, {3, 2}, {2, 1}, {2, 0}, {3, 1}, {3, 0}
+};
+
+/**
+ * Draw a bitmap made by tools/bitmap_compile.py (see vma419.h)
+ *
+ * RAW and RLE are read as one stream of row bytes: RLE unpacks on the fly
+ * with two bytes of state, so no buffer is needed for either.
+ *
+ * @param disp Pointer to VMA419 display structure
+ * @param x Column of the left edge (may be negative)
+ * @param y Row of the top edge (may be negative)
+ * @param bitmap PROGMEM bitmap including its header
+ * @return 0 on success, -1 for an unknown format or a WIRE size mismatch
+ */
+int vma419_draw_bitmap_P(VMA419_Display* disp, int16_t x, int16_t y, const uint8_t* bitmap) {
+    if (!disp || !disp->frame_buffer || !bitmap) return -1;
+
+    uint8_t format = pgm_read_byte(bitmap);
+    uint16_t width = pgm_read_byte(bitmap + 1) | (pgm_read_byte(bitmap + 2) << 8);
+    uint8_t height = pgm_read_byte(bitmap + 3);
+    const uint8_t* data = bitmap + VMA419_BITMAP_HEADER_SIZE;
+
+    if (format == VMA419_BITMAP_WIRE) {
+        // Already in frame buffer order: just put every byte where the scan reads it
+        if (x != 0 || y != 0 || width != disp->total_width_pixels || height != disp->total_height_pixels) {
+            return -1;
+        }
+        uint16_t displays_total = disp->panels_wide * disp->panels_high;
+        uint16_t rowsize = displays_total << 2;
+        uint16_t group = displays_total << 4;   // distance between the 4 rows of one phase
+
+        for (uint8_t cycle = 0; cycle < 4; cycle++) {
+            uint16_t offset = rowsize * cycle;
+            disp->phase_lit[cycle] = 0;             // Every byte of the phase is replaced
+            for (uint16_t panel = 0; panel < displays_total; panel++) {
+                for (uint8_t i = 0; i < 16; i++) {
+                    uint8_t column = pgm_read_byte(&vma419_wire_order[i][0]);
+                    uint8_t k = pgm_read_byte(&vma419_wire_order[i][1]);
+                    uint8_t byte = pgm_read_byte(data++);
+                    disp->frame_buffer[offset + column + k * group] = byte;
+                    disp->phase_lit[cycle] += vma419_popcount(byte);
+                }
+                offset += 4;
+            }
+        }
+        return 0;
+    }
+
+    if (format != VMA419_BITMAP_RAW && format != VMA419_BITMAP_RLE) return -1;
+
+    uint8_t bytes_per_row = (width + 7) / 8;
+    uint8_t last_mask = (width & 0x07) ? (uint8_t)(0xFF << (8 - (width & 0x07))) : 0xFF;
+    uint8_t run = 0;                        // RLE: bytes left in the current run
+    uint8_t repeat = 0;                     // RLE: 1 = run repeats one byte, 0 = literal bytes
+    uint8_t value = 0;
+
+    for (uint8_t r = 0; r < height; r++) {
+        int16_t row_y = y + r;
+        if (row_y >= (int16_t)disp->total_height_pixels) break;   // nothing below is visible
+
+        for (uint8_t c = 0; c < bytes_per_row; c++) {
+            // Next byte of the row stream
+            if (format == VMA419_BITMAP_RAW) {
+                value = pgm_read_byte(data++);
+            } else {
+                if (run == 0) {
+                    uint8_t n = pgm_read_byte(data++);
+                    repeat = (n >= 128);
+                    run = repeat ? n - 125 : n + 1;
+                    if (repeat) value = pgm_read_byte(data++);
+                }
+                if (!repeat) value = pgm_read_byte(data++);
+                run--;
+            }
+
+            if (row_y >= 0) {
+                vma419_write_byte(disp, x + 8 * c, row_y, value, (c == bytes_per_row - 1) ? last_mask : 0xFF);
+            }
+        }
+    }
+    return 0;
+}
+
+// ===============================================
+// ROW FONTS
+// ===============================================
+
+// Width of character c in a row font, 0 if the font does not have it
+static uint8_t vma419_glyph_width_P(const uint8_t* font, uint8_t c) {
+    uint8_t first = pgm_read_byte(font + 1);
+    uint8_t count = pgm_read_byte(font + 2);
+    if (c < first || c - first >= count) return 0;
+    return pgm_read_byte(font + VMA419_ROWFONT_HEADER_SIZE + (c - first));
+}
+
+/**
+ * Draw one character of a row font (see vma419.h for the layout)
+ *
+ * Each glyph row is at most a few bytes, written with vma419_write_byte()
+ * with the glyph bits as the mask, so only "on" pixels are touched.
+ *
+ * @param disp Pointer to VMA419 display structure
+ * @param x Column of the left edge (may be negative)
+ * @param y Row of the top edge (may be negative)
+ * @param font PROGMEM row font
+ * @param c Character to draw
+ * @return Width of the character, 0 if it is not in the font
+ */
+uint8_t vma419_draw_glyph_P(VMA419_Display* disp, int16_t x, int16_t y, const uint8_t* font, uint8_t c) {
+    uint8_t width = vma419_glyph_width_P(font, c);
+    if (!width || !disp || !disp->frame_buffer) return width;
+    if (x >= (int16_t)disp->total_width_pixels || x + width <= 0) return width;
+
+    uint8_t height = pgm_read_byte(font);
+    uint8_t count = pgm_read_byte(font + 2);
+    uint8_t index = c - pgm_read_byte(font + 1);
+    const uint8_t* offsets = font + VMA419_ROWFONT_HEADER_SIZE + count;
+    uint16_t offset = pgm_read_byte(offsets + 2 * index) | (pgm_read_byte(offsets + 2 * index + 1) << 8);
+    const uint8_t* data = offsets + 2 * count + offset;
+    uint8_t bytes_per_row = (width + 7) / 8;
+
+    for (uint8_t r = 0; r < height; r++, data += bytes_per_row) {
+        int16_t row_y = y + r;
+        if (row_y < 0) continue;
+        if (row_y >= (int16_t)disp->total_height_pixels) break;
+
+        for (uint8_t b = 0; b < bytes_per_row; b++) {
+            uint8_t bits = pgm_read_byte(data + b);
+            if (bits) vma419_write_byte(disp, x + 8 * b, row_y, bits, bits);
+        }
+    }
+    return width;
+}
+
+/**
+ * Draw text in a row font, characters spaced by the font's spacing
+ * @param disp Pointer to VMA419 display structure
+ * @param x Column of the first character (may be negative)
+ * @param y Row of the top edge
+ * @param font PROGMEM row font
+ * @param text Null-terminated string
+ * @return Cursor position after the last character drawn
+ */
+int16_t vma419_draw_text_P(VMA419_Display* disp, int16_t x, int16_t y, const uint8_t* font, const char* text) {
+    if (!disp || !font || !text) return x;
+    uint8_t spacing = pgm_read_byte(font + 3);
+
+    while (*text && x < (int16_t)disp->total_width_pixels) {
+        x += vma419_draw_glyph_P(disp, x, y, font, (uint8_t)*text++) + spacing;
+    }
+    return x;
+}
+
+/**
+ * Width of text in a row font, as vma419_draw_text_P() would advance
+ * @param font PROGMEM row font
+ * @param text Null-terminated string
+ * @return Width in pixels
+ */
+uint16_t vma419_text_width_P(const uint8_t* font, const char* text) {
+    if (!font || !text) return 0;
+    uint8_t spacing = pgm_read_byte(font + 3);
+    uint16_t width = 0;
+
+    while (*text) {
+        width += vma419_glyph_width_P(font, (uint8_t)*text++) + spacing;
+    }
+    return width;
+}
+
+/**
  * Select row pair for multiplexed scanning
  * 
  * The VMA419 uses 4-phase multiplexing where rows are grouped into pairs:
@@ -368,8 +903,10 @@ static void select_row_pair(VMA419_Display* disp, uint8_t row_pair) {
 void vma419_scan_display_quarter(VMA419_Display* disp) {
     if (!disp || !disp->frame_buffer) return;
 
-    // Disable display output during data transfer
+    // Disable display output during data transfer (and cancel a pulse
+    // that is still running if this phase came early)
     PIN_SET_HIGH(disp->pins.oe_port_out, disp->pins.oe_pin_mask);
+    if (disp->oe_on_ticks) TCCR2 = 0;
 
     // Select the current row group for this scan cycle
     select_row_pair(disp, disp->scan_cycle);
@@ -379,35 +916,37 @@ void vma419_scan_display_quarter(VMA419_Display* disp) {
     uint16_t rowsize = displays_total << 2;  // displays_total * 4 bytes per panel row
     uint16_t offset = rowsize * disp->scan_cycle;
     
-    // Calculate row offset addresses for 4-row multiplexing
-    // These match the DMD419 row addressing pattern
-    uint16_t row1 = displays_total << 4;    // displays_total * 16
-    uint16_t row2 = displays_total << 5;    // displays_total * 32  
-    uint16_t row3 = displays_total * 48;    // displays_total * 48
+    // The 4 rows of one phase are displays_total * 16 bytes apart
+    // (DMD419 row addressing pattern)
+    int16_t row_step = displays_total << 4;
     
-    // Send data for all panels in the specific DMD419 SPI pattern
-    // Each panel sends 16 bytes in this exact order for proper display
-    for (uint16_t panel = 0; panel < displays_total; panel++) {
-        // Send 16 bytes per panel in DMD419 order
-        spi_transfer(disp->frame_buffer[offset + 0 + row3]);
-        spi_transfer(disp->frame_buffer[offset + 0 + row2]);
-        spi_transfer(disp->frame_buffer[offset + 1 + row3]);
-        spi_transfer(disp->frame_buffer[offset + 1 + row2]);
-        spi_transfer(disp->frame_buffer[offset + 0 + row1]);
-        spi_transfer(disp->frame_buffer[offset + 0]);
-        spi_transfer(disp->frame_buffer[offset + 1 + row1]);
-        spi_transfer(disp->frame_buffer[offset + 1]);
-        spi_transfer(disp->frame_buffer[offset + 2 + row3]);
-        spi_transfer(disp->frame_buffer[offset + 2 + row2]);
-        spi_transfer(disp->frame_buffer[offset + 3 + row3]);
-        spi_transfer(disp->frame_buffer[offset + 3 + row2]);
-        spi_transfer(disp->frame_buffer[offset + 2 + row1]);
-        spi_transfer(disp->frame_buffer[offset + 2]);
-        spi_transfer(disp->frame_buffer[offset + 3 + row1]);
-        spi_transfer(disp->frame_buffer[offset + 3]);
-        
-        // Move to next panel's data
-        offset += 4;
+    // Send 16 bytes per panel in the DMD419 order (see vma419_scan_output)
+    uint8_t lit_phase = disp->scan_cycle;
+    if (!disp->scan_panels) {
+        vma419_scan_output(disp->frame_buffer + offset + row_step, row_step, (uint8_t)displays_total);
+    } else {
+        // Turned, mirrored or rewired: each panel from its tile. Upside
+        // down, the rows of this phase are those of the other phase in the
+        // pair (logical row 15 - y) sent bottom up.
+        const VMA419_ScanPanel* panel = disp->scan_panels;
+        for (uint8_t n = (uint8_t)displays_total; n; n--, panel++) {
+            const uint8_t* rows = disp->frame_buffer + panel->offset;
+            if (panel->flags & VMA419_ORIENT_MIRROR_Y) {
+                rows += rowsize * (disp->scan_cycle ^ 1) + 2 * row_step;
+                if (panel->flags & VMA419_ORIENT_MIRROR_X) vma419_scan_output_reversed(rows, -row_step);
+                else vma419_scan_output(rows, -row_step, 1);
+            } else {
+                rows += offset + row_step;
+                if (panel->flags & VMA419_ORIENT_MIRROR_X) vma419_scan_output_reversed(rows, row_step);
+                else vma419_scan_output(rows, row_step, 1);
+            }
+        }
+        // The LEDs lit now are those of the pair's other phase when every
+        // panel is upside down; with only some, take the busier of the two
+        if (disp->lit_phase_swap == 1 ||
+            (disp->lit_phase_swap == 2 && disp->phase_lit[lit_phase ^ 1] > disp->phase_lit[lit_phase])) {
+            lit_phase ^= 1;
+        }
     }
 
     // Latch the data from shift registers to output latches
@@ -415,8 +954,196 @@ void vma419_scan_display_quarter(VMA419_Display* disp) {
     _delay_us(10); // Latch pulse duration
     PIN_SET_LOW(disp->pins.latch_clk_port_out, disp->pins.latch_clk_pin_mask);
 
-    // Enable display output for the selected row group
-    PIN_SET_LOW(disp->pins.oe_port_out, disp->pins.oe_pin_mask);
+    // Enable display output for the selected row group: until the next
+    // scan, or for as long as the LEDs lit in this phase allow (Timer2 ends it)
+    if (!disp->oe_on_ticks) {
+        PIN_SET_LOW(disp->pins.oe_port_out, disp->pins.oe_pin_mask);
+        return;
+    }
+    uint8_t on_ticks = vma419_phase_on_ticks(disp, lit_phase);
+    if (on_ticks) {
+        TCNT2 = 0;
+        OCR2 = on_ticks;
+        TIFR = (1 << OCF2);                 // No compare match left over from before
+        PIN_SET_LOW(disp->pins.oe_port_out, disp->pins.oe_pin_mask);
+        TCCR2 = (1 << CS21) | (1 << CS20);  // Count at fosc/32 (VMA419_OE_TICK_US)
+    }
+}
+
+/**
+ * Time every phase's OE pulse by its lit LEDs (see vma419.h)
+ *
+ * Builds oe_curve[]: for point k (k/16 of the phase lit) the on-time share
+ *   droop: (100 - droop) / (100 - droop * k/16)   as bright as a full phase
+ *   cap:   cap / (100 * k/16)                     LEDs x on-time <= cap
+ * whichever is smaller. The divisions happen here, not in the scan.
+ *
+ * @param disp Pointer to VMA419 display structure
+ * @param on_ticks On-time of a phase in Timer2 ticks (0 = OE on until the next scan)
+ * @param droop_percent Brightness lost with a whole phase lit (0-90)
+ * @param cap_percent Current cap in percent of a fully lit phase (1-100)
+ */
+void vma419_set_oe_timing(VMA419_Display* disp, uint8_t on_ticks, uint8_t droop_percent, uint8_t cap_percent) {
+    if (!disp) return;
+    if (droop_percent > 90) droop_percent = 90;
+    if (cap_percent < 1) cap_percent = 1;
+    if (cap_percent > 100) cap_percent = 100;
+
+    for (uint8_t k = 0; k < VMA419_OE_CURVE_POINTS; k++) {
+        uint32_t scale = 255UL * (100 - droop_percent) * 16 / (1600 - (uint16_t)droop_percent * k);
+        if (k > 0) {
+            uint32_t cap = 255UL * cap_percent * 16 / (100UL * k);
+            if (scale > cap) scale = cap;
+        }
+        disp->oe_curve[k] = (scale > 255) ? 255 : (uint8_t)scale;
+    }
+
+    TCCR2 = 0;                              // No pulse running while this changes
+    disp->oe_on_ticks = on_ticks;
+    if (on_ticks) {
+        vma419_oe_port = disp->pins.oe_port_out;
+        vma419_oe_mask = disp->pins.oe_pin_mask;
+        TIMSK |= (1 << OCIE2);
+    } else {
+        TIMSK &= ~(1 << OCIE2);
+    }
+}
+
+/**
+ * Change the on-time of timed OE without rebuilding the curve (see vma419.h)
+ *
+ * @param disp Pointer to VMA419 display structure
+ * @param on_ticks On-time of a phase in Timer2 ticks (1-255)
+ */
+void vma419_set_oe_on_ticks(VMA419_Display* disp, uint8_t on_ticks) {
+    if (!disp || !disp->oe_on_ticks || !on_ticks) return;
+    disp->oe_on_ticks = on_ticks;           // One byte: the scan sees old or new
+}
+
+/**
+ * Count the lit LEDs of every phase from scratch (see vma419.h)
+ *
+ * @param disp Pointer to VMA419 display structure
+ */
+void vma419_count_lit(VMA419_Display* disp) {
+    if (!disp || !disp->frame_buffer) return;
+
+    uint16_t rowsize = (disp->panels_wide * disp->panels_high) << 2;
+    const uint8_t* byte = disp->frame_buffer;
+    memset(disp->phase_lit, 0, sizeof(disp->phase_lit));
+
+    for (uint16_t row = 0; row < disp->frame_buffer_size / rowsize; row++) {
+        for (uint16_t i = 0; i < rowsize; i++) {
+            disp->phase_lit[row & 0x03] += vma419_popcount(*byte++);
+        }
+    }
+}
+
+/*
+ * Build the scan's panel table from the chain map and the orientation
+ *
+ * For chain position n: the tile it is mounted at (chain map, or n % wide,
+ * n / wide), moved to the opposite side when the whole picture is mirrored,
+ * gives the frame buffer panel it shows (column + wide x row, as in
+ * vma419_set_pixel). Its flags are the panel's own turn combined with the
+ * picture's. When that comes out as the plain order the table is dropped and
+ * the scan goes back to its single burst over all panels.
+ *
+ * @return 0 on success, -1 if there is no memory for the table
+ */
+static int vma419_build_scan_panels(VMA419_Display* disp) {
+    uint8_t displays_total = disp->panels_wide * disp->panels_high;
+    VMA419_ScanPanel* panels = disp->scan_panels;
+    if (!panels) {
+        panels = (VMA419_ScanPanel*)malloc(displays_total * sizeof(VMA419_ScanPanel));
+        if (!panels) return -1;
+    }
+
+    uint8_t reordered = 0, upside_down = 0;
+    for (uint8_t n = 0; n < displays_total; n++) {
+        uint8_t column = n % disp->panels_wide;
+        uint8_t row = n / disp->panels_wide;
+        uint8_t flags = disp->orientation;
+        if (disp->chain) {
+            column = pgm_read_byte(&disp->chain[n].column);
+            row = pgm_read_byte(&disp->chain[n].row);
+            flags ^= pgm_read_byte(&disp->chain[n].orientation);
+        }
+        if (disp->orientation & VMA419_ORIENT_MIRROR_X) column = disp->panels_wide - 1 - column;
+        if (disp->orientation & VMA419_ORIENT_MIRROR_Y) row = disp->panels_high - 1 - row;
+
+        uint16_t offset = (uint16_t)(row * disp->panels_wide + column) * 4;
+        if (offset != (uint16_t)n * 4 || flags) reordered = 1;
+        if (flags & VMA419_ORIENT_MIRROR_X) offset += 3;    // Sent from its last byte
+        if (flags & VMA419_ORIENT_MIRROR_Y) upside_down++;
+        panels[n].offset = offset;
+        panels[n].flags = flags;
+    }
+
+    if (!reordered) {
+        free(panels);                       // Back to the single burst of all panels
+        panels = NULL;
+    }
+    disp->scan_panels = panels;
+    disp->lit_phase_swap = (upside_down == 0) ? 0 : (upside_down == displays_total) ? 1 : 2;
+    return 0;
+}
+
+/**
+ * Turn or mirror the picture at scan time (see vma419.h)
+ *
+ * @param disp Pointer to VMA419 display structure
+ * @param orientation VMA419_ORIENT_NORMAL, _MIRROR_X, _MIRROR_Y or _ROTATE_180
+ * @return 0 on success, -1 on failure
+ */
+int vma419_set_orientation(VMA419_Display* disp, uint8_t orientation) {
+    if (!disp || !disp->frame_buffer || orientation > VMA419_ORIENT_ROTATE_180) {
+        return -1;
+    }
+    uint8_t old_orientation = disp->orientation;
+    disp->orientation = orientation;
+    if (vma419_build_scan_panels(disp) != 0) {
+        disp->orientation = old_orientation;
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * Set the order and mounting of the panels of a wall (see vma419.h)
+ *
+ * Checks the whole map first: every tile inside the display, none twice
+ * (with as many entries as panels, that is every tile exactly once).
+ *
+ * @param disp Pointer to VMA419 display structure
+ * @param chain panels_wide x panels_high tiles in chain order (PROGMEM), or NULL
+ * @return 0 on success, -1 on failure
+ */
+int vma419_set_chain_P(VMA419_Display* disp, const VMA419_ChainTile* chain) {
+    if (!disp || !disp->frame_buffer) return -1;
+
+    uint8_t displays_total = disp->panels_wide * disp->panels_high;
+    for (uint8_t n = 0; chain && n < displays_total; n++) {
+        uint8_t column = pgm_read_byte(&chain[n].column);
+        uint8_t row = pgm_read_byte(&chain[n].row);
+        if (column >= disp->panels_wide || row >= disp->panels_high ||
+            pgm_read_byte(&chain[n].orientation) > VMA419_ORIENT_ROTATE_180) {
+            return -1;
+        }
+        for (uint8_t m = 0; m < n; m++) {
+            if (pgm_read_byte(&chain[m].column) == column && pgm_read_byte(&chain[m].row) == row) {
+                return -1;
+            }
+        }
+    }
+
+    const VMA419_ChainTile* old_chain = disp->chain;
+    disp->chain = chain;
+    if (vma419_build_scan_panels(disp) != 0) {
+        disp->chain = old_chain;
+        return -1;
+    }
+    return 0;
 }
 
 /*
@@ -456,8 +1183,8 @@ void vma419_scan_display_quarter(VMA419_Display* disp) {
  *    cycling through scan_cycle 0-3 for full display refresh
  * * PERFORMANCE NOTES:
  * - Recommended refresh rate: 200-500 Hz (1-2.5ms per phase)
- * - Hardware SPI: ~1μs per byte (optimized data transfer)
- * - Full scan cycle: ~250μs for single panel with hardware SPI
+ * - Hardware SPI at fosc/2: 2.25μs per byte (18 cycles, unrolled assembly)
+ * - SPI burst: 36μs per panel and phase (VMA419_SCAN_BURST_CYCLES)
  * - Memory usage: 64 bytes RAM per panel + structure overhead
  * 
  * COMPATIBILITY:
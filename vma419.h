@@ -56,7 +56,117 @@
 #define VMA419_GRAPHICS_NOR       4    // Subtract-only mode: can only turn LEDs off, never on
 
 //------------------------------------------------------------------------------
-// PIXEL LOOKUP TABLE (makes the code run faster)
+// BITMAP FORMATS (for pictures stored in flash, see vma419_draw_bitmap_P)
+//------------------------------------------------------------------------------
+// tools/bitmap_compile.py turns PBM/PGM/PNG images into PROGMEM arrays.
+// Every array starts with a 4-byte header: format, width (low, high byte), height.
+
+#define VMA419_BITMAP_HEADER_SIZE 4
+#define VMA419_BITMAP_RAW         0    // Row by row, (width+7)/8 bytes per row, MSB = leftmost, 1 = LED on
+#define VMA419_BITMAP_WIRE        1    // Frame buffer bytes in the order the scan sends them (whole display only)
+#define VMA419_BITMAP_RLE         2    // RAW bytes, run-length compressed:
+                                       //   n = 0-127: n+1 bytes follow as they are
+                                       //   n = 128-255: the next byte repeats n-125 times (3-130)
+
+//------------------------------------------------------------------------------
+// ROW FONTS (glyphs stored like the frame buffer, see vma419_draw_text_P)
+//------------------------------------------------------------------------------
+// tools/font_compile.py turns BDF fonts, VMA419_Font.h and FontCreator fonts
+// into these. Every glyph is stored row by row, MSB = leftmost pixel, so a
+// glyph row goes into the frame buffer with one or two byte operations
+// instead of one vma419_set_pixel() per bit. Layout of the PROGMEM array:
+//   height, first character, character count, spacing (pixels after a glyph)
+//   widths[count]     width of each glyph in pixels, 0 = not in the font
+//   offsets[count]    2 bytes each (low byte first), glyph position in the data
+//   data              per glyph: height rows of (width+7)/8 bytes
+
+#define VMA419_ROWFONT_HEADER_SIZE 4
+
+//------------------------------------------------------------------------------
+// SCAN TIMING (cycle-exact model of the SPI burst in vma419_scan_display_quarter)
+//------------------------------------------------------------------------------
+// SPI runs at fosc/2 (4 MHz at 8 MHz), so one byte shifts out in 16 CPU cycles.
+// On the AVR the burst is unrolled assembly that writes SPDR every
+// VMA419_SCAN_SLOT_CYCLES cycles and loads the next frame buffer byte while
+// the current one shifts, without polling SPIF. Per panel that is
+// 16 bytes x 18 cycles = 288 cycles (36 us); interrupts can only stretch it.
+
+#define VMA419_SPI_CYCLES_PER_BYTE      16   // 8 bits at fosc/2 (SPI2X)
+#define VMA419_SCAN_SLOT_CYCLES         18   // Between two SPDR writes: 16 + 2 spare (17 is the minimum)
+#define VMA419_SCAN_BYTES_PER_PANEL     16   // 4 rows x 4 bytes per scan phase
+#define VMA419_SCAN_BURST_SETUP_CYCLES   4   // Loading the first byte before the first write
+#define VMA419_SCAN_BURST_CYCLES(panels) \
+    (VMA419_SCAN_BURST_SETUP_CYCLES + (uint16_t)(panels) * VMA419_SCAN_BYTES_PER_PANEL * VMA419_SCAN_SLOT_CYCLES)
+
+// A turned or mirrored display (vma419_set_orientation) is sent one panel per
+// call: each panel takes its setup + 16 slots plus the call in between.
+// Panels mirrored left to right read every byte through a bit-reversal table.
+#define VMA419_SCAN_MIRROR_SETUP_CYCLES  8   // First byte through the table before the first write
+#define VMA419_SCAN_PANEL_CYCLES(setup) \
+    ((setup) + VMA419_SCAN_BYTES_PER_PANEL * VMA419_SCAN_SLOT_CYCLES)
+
+//------------------------------------------------------------------------------
+// DISPLAY ORIENTATION AND PANEL CHAIN (see vma419_set_orientation, vma419_set_chain_P)
+//------------------------------------------------------------------------------
+// Everything is still drawn upright into the frame buffer, as one picture of
+// total_width_pixels x total_height_pixels; only the scan sends it turned,
+// mirrored or in the order the cable runs through the panels. Drawing, fonts
+// and the frame buffer stay the same.
+
+#define VMA419_ORIENT_NORMAL      0
+#define VMA419_ORIENT_MIRROR_X    1    // Left and right swapped (seen from behind glass)
+#define VMA419_ORIENT_MIRROR_Y    2    // Top and bottom swapped
+#define VMA419_ORIENT_ROTATE_180  3    // Both: the panels are mounted upside down
+
+// Where one panel of the chain is mounted: which 32x16 tile of the picture
+// it shows (column 0 = left, row 0 = top) and how it is turned. An array of
+// these, one per panel in chain order, describes a wall (PROGMEM).
+// Chain position 0 is the panel at the far end of the cable: the scan sends
+// its bytes first, so they are shifted through all the others.
+typedef struct {
+    uint8_t column;                 // Tile column, 0 to panels_wide - 1
+    uint8_t row;                    // Tile row, 0 to panels_high - 1
+    uint8_t orientation;            // VMA419_ORIENT_ROTATE_180 if mounted upside down
+} VMA419_ChainTile;
+
+// What the scan sends at one position of the panel chain (built from the
+// chain and the orientation, so the scan only adds offsets)
+typedef struct {
+    uint16_t offset;                // Frame buffer byte of its first row in phase 0 (+3 if mirrored left to right)
+    uint8_t flags;                  // VMA419_ORIENT_* for this panel
+} VMA419_ScanPanel;
+
+//------------------------------------------------------------------------------
+// LOAD-AWARE OE TIMING (see vma419_set_oe_timing)
+//------------------------------------------------------------------------------
+// Every phase lights a different number of LEDs. On a weak supply a busy
+// phase droops and looks dimmer than a sparse one. The driver keeps count of
+// the lit LEDs per phase and ends each phase's OE pulse with Timer2 (compare
+// match interrupt), so the LED on-time can follow the load.
+
+#define VMA419_OE_TICK_US        4     // Timer2 at fosc/32: one tick = 4 us at 8 MHz
+#define VMA419_OE_PHASE_TICKS  240     // 960 us: about the 1 ms phase of the main loop
+#define VMA419_OE_CURVE_POINTS  17     // On-time scale for 0/16, 1/16 ... 16/16 of a phase lit
+
+// The OE pin of the display with timed OE (set by vma419_set_oe_timing)
+extern volatile uint8_t* vma419_oe_port;
+extern uint8_t vma419_oe_mask;
+
+/**
+ * End of a phase's on-time: OE high (LEDs off) and stop Timer2
+ * until vma419_scan_display_quarter() starts the next pulse.
+ * The driver does not own TIMER2_COMP_vect, so programs that link vma419.c
+ * keep Timer2 for themselves unless they use timed OE. Those that do put
+ * VMA419_OE_TIMER2_ISR() in one .c file, or call this from their own
+ * ISR(TIMER2_COMP_vect) if Timer2 has other work there too.
+ */
+static inline void vma419_oe_pulse_end(void) {
+    *vma419_oe_port |= vma419_oe_mask;
+    TCCR2 = 0;
+}
+
+#define VMA419_OE_TIMER2_ISR() ISR(TIMER2_COMP_vect) { vma419_oe_pulse_end(); }
+
 //------------------------------------------------------------------------------
 // This is a pre-calculated table that helps us quickly find which bit controls which LED.
 // Think of it like a cheat sheet - instead of doing math every time, we just look up the answer.
@@ -154,6 +264,18 @@ typedef struct {
     
     uint8_t scan_cycle;             // Which row group is being displayed right now (0, 1, 2, or 3)
                                     // This cycles through 0→1→2→3→0→1→2→3... very quickly
+    
+    uint16_t phase_lit[4];          // How many LEDs each scan phase lights; every drawing
+                                    // function keeps this up to date as it changes the image
+    uint16_t lit_scale;             // 32768 / LEDs per phase: phase_lit × lit_scale / 128 = share lit (0-256)
+    uint8_t oe_on_ticks;            // OE on-time per phase in VMA419_OE_TICK_US steps (0 = until the next scan)
+    uint8_t oe_curve[VMA419_OE_CURVE_POINTS]; // Share of oe_on_ticks (255 = all) by share of the phase lit
+
+    VMA419_ScanPanel* scan_panels;  // One per panel in chain order, NULL = sent as drawn
+    const VMA419_ChainTile* chain;  // PROGMEM chain map (vma419_set_chain_P), NULL = left to right, top to bottom
+    uint8_t orientation;            // VMA419_ORIENT_* of the whole picture
+    uint8_t lit_phase_swap;         // OE timing uses phase_lit of: 0 = this phase, 1 = its pair
+                                    // (all panels upside down), 2 = the busier of both (some are)
 } VMA419_Display;
 
 //==============================================================================
@@ -260,6 +382,62 @@ void vma419_set_pixel(VMA419_Display* disp, uint16_t x, uint16_t y, uint8_t colo
  */
 void vma419_write_pixel(VMA419_Display* disp, uint16_t x, uint16_t y, uint8_t graphics_mode, uint8_t pixel);
 
+/**
+ * DRAW A PICTURE STORED IN FLASH (logos, icons)
+ *
+ * Unpacks a bitmap made by tools/bitmap_compile.py straight into the frame
+ * buffer, without a copy in RAM. Pixels that are 0 in the picture are turned
+ * off, so the picture replaces whatever was under its rectangle.
+ *
+ * How to use it:
+ * @param disp - Pointer to your display structure
+ * @param x, y - Where the top left corner goes (may be partly off screen)
+ * @param bitmap - The PROGMEM array, header included
+ * @return 0 on success, -1 if the format is unknown or a WIRE bitmap does
+ *         not match the display size (those must be drawn at 0, 0)
+ *
+ * Which format to pick:
+ * - RAW: simplest, fastest when x is a multiple of 8 (whole bytes are copied)
+ * - RLE: smallest for pictures with large plain areas
+ * - WIRE: fastest of all (one byte copy per frame buffer byte), full screen only
+ */
+int vma419_draw_bitmap_P(VMA419_Display* disp, int16_t x, int16_t y, const uint8_t* bitmap);
+
+/**
+ * DRAW ONE CHARACTER OF A ROW FONT (made by tools/font_compile.py)
+ *
+ * Only the "on" pixels are drawn, like vma419_font_draw_char().
+ *
+ * @param disp - Pointer to your display structure
+ * @param x, y - Top left corner of the character (may be partly off screen)
+ * @param font - The PROGMEM font array
+ * @param c - The character
+ * @return Width of the character in pixels (0 if the font does not have it)
+ */
+uint8_t vma419_draw_glyph_P(VMA419_Display* disp, int16_t x, int16_t y, const uint8_t* font, uint8_t c);
+
+/**
+ * DRAW TEXT IN A ROW FONT
+ *
+ * Stops as soon as the next character would start right of the display.
+ *
+ * @param disp - Pointer to your display structure
+ * @param x, y - Top left corner of the first character
+ * @param font - The PROGMEM font array
+ * @param text - Null-terminated string
+ * @return The x where the next character would go
+ */
+int16_t vma419_draw_text_P(VMA419_Display* disp, int16_t x, int16_t y, const uint8_t* font, const char* text);
+
+/**
+ * WIDTH OF TEXT IN A ROW FONT (in pixels, including the spacing after the last character)
+ *
+ * @param font - The PROGMEM font array
+ * @param text - Null-terminated string
+ * @return Number of pixels vma419_draw_text_P() would move the cursor
+ */
+uint16_t vma419_text_width_P(const uint8_t* font, const char* text);
+
 /**
  * REFRESH THE DISPLAY (the most important function!)
  * 
@@ -297,6 +475,106 @@ void vma419_write_pixel(VMA419_Display* disp, uint16_t x, uint16_t y, uint8_t gr
  */
 void vma419_scan_display_quarter(VMA419_Display* disp);
 
+/**
+ * LOAD-AWARE BRIGHTNESS (time each phase's OE pulse by how many LEDs it lights)
+ * 
+ * By default the LEDs stay on from one vma419_scan_display_quarter() to the
+ * next. After this call every phase is lit for a set time instead, ended by
+ * Timer2 (so Timer2 is no longer free for other uses), and that time depends
+ * on the LEDs lit in the phase. The program must route Timer2's compare
+ * interrupt to the driver: VMA419_OE_TIMER2_ISR() in one of its .c files
+ * (with <avr/interrupt.h>), or vma419_oe_pulse_end() from its own ISR.
+ * Without it the first phase jumps to the missing vector and resets the chip.
+ * 
+ * - droop_percent: how much dimmer an LED gets when its whole phase is lit
+ *   (on your power supply). Sparser phases get less on-time so that every
+ *   phase looks as bright as a full one. 0 = no compensation.
+ * - cap_percent: most LEDs of a phase that may be lit for the full on_ticks.
+ *   Busier phases get proportionally less on-time, so LEDs × on-time (the
+ *   average current of a phase) never goes above that. 100 = no cap.
+ * 
+ * The per-phase cost is a table lookup and two multiplications in the scan.
+ * 
+ * @param disp - Pointer to your display structure
+ * @param on_ticks - On-time of a phase in 4 us ticks, 1-255 (VMA419_OE_PHASE_TICKS
+ *                   fits the 1 ms phase); 0 = back to "on until the next scan"
+ * @param droop_percent - Brightness lost with a whole phase lit (0-90)
+ * @param cap_percent - Current cap in percent of a fully lit phase (1-100)
+ */
+void vma419_set_oe_timing(VMA419_Display* disp, uint8_t on_ticks, uint8_t droop_percent, uint8_t cap_percent);
+
+/**
+ * CHANGE THE BRIGHTNESS (on-time of a phase, after vma419_set_oe_timing)
+ * 
+ * Only the on_ticks of vma419_set_oe_timing() change; the droop and cap
+ * curve stays. Takes effect from the next scan phase, so it can be called
+ * as often as needed (ambient_light.h does, every main loop pass).
+ * Does nothing while timed OE is off.
+ * 
+ * @param disp - Pointer to your display structure
+ * @param on_ticks - On-time of a phase in 4 us ticks (1-255)
+ */
+void vma419_set_oe_on_ticks(VMA419_Display* disp, uint8_t on_ticks);
+
+/**
+ * COUNT THE LIT LEDS AGAIN (only needed after writing frame_buffer directly)
+ * 
+ * The drawing functions keep phase_lit[] up to date on their own. Code that
+ * changes disp->frame_buffer itself (memcpy, its own loops) calls this after.
+ * 
+ * @param disp - Pointer to your display structure
+ */
+void vma419_count_lit(VMA419_Display* disp);
+
+/**
+ * TURN OR MIRROR THE PICTURE (for panels mounted upside down or behind glass)
+ *
+ * Keep drawing as if the display were upright; the scan sends every phase
+ * turned or mirrored. Nothing is redrawn or copied, and drawing is exactly
+ * as fast as before. Panels mirrored left to right cost 4 cycles more per
+ * panel and phase (a bit-reversal table in flash), the rest nothing beyond
+ * one call per panel. Takes effect from the next scan phase.
+ *
+ * @param disp - Pointer to your display structure
+ * @param orientation - VMA419_ORIENT_NORMAL, _MIRROR_X, _MIRROR_Y or _ROTATE_180
+ * @return 0 if it worked, -1 for a bad orientation or not enough memory
+ *         (it takes a table of 3 bytes per panel)
+ *
+ * With a chain map (vma419_set_chain_P) this turns the whole wall: each
+ * panel's own orientation is combined with this one.
+ */
+int vma419_set_orientation(VMA419_Display* disp, uint8_t orientation);
+
+/**
+ * TELL THE DRIVER HOW THE PANELS OF A WALL ARE WIRED
+ *
+ * By default the chain runs left to right, then top to bottom, every panel
+ * upright. Walls are often wired differently, for example as a serpentine
+ * (every other row runs back and is mounted upside down so the cables stay
+ * short) or in columns. Give one VMA419_ChainTile per panel in chain order
+ * (position 0 = far end of the cable), in flash:
+ *
+ *   // 4x2 serpentine, the controller plugged into the bottom left panel
+ *   static const VMA419_ChainTile wall[8] PROGMEM = {
+ *       {0, 0, VMA419_ORIENT_NORMAL}, {1, 0, VMA419_ORIENT_NORMAL},
+ *       {2, 0, VMA419_ORIENT_NORMAL}, {3, 0, VMA419_ORIENT_NORMAL},
+ *       {3, 1, VMA419_ORIENT_ROTATE_180}, {2, 1, VMA419_ORIENT_ROTATE_180},
+ *       {1, 1, VMA419_ORIENT_ROTATE_180}, {0, 1, VMA419_ORIENT_ROTATE_180},
+ *   };
+ *   vma419_init(&display, &pins, 4, 2);
+ *   vma419_set_chain_P(&display, wall);
+ *
+ * The map is turned into a table of frame buffer offsets once, here; the
+ * drawing functions still see one 128x32 picture and cost nothing more.
+ * The array must stay in flash for as long as the display is used.
+ *
+ * @param disp - Pointer to your display structure
+ * @param chain - panels_wide x panels_high tiles in PROGMEM, NULL = the default order
+ * @return 0 if it worked, -1 if a tile is outside the display or used twice
+ *         (nothing changes then), or not enough memory
+ */
+int vma419_set_chain_P(VMA419_Display* disp, const VMA419_ChainTile* chain);
+
 /**
  * CLEAN UP AND FREE MEMORY (call this when you're done)
  * 